@@ -248,7 +248,7 @@ void visitor::add_entity(const cppast::cpp_entity& entity) {
       logger::warn(fmt::format("Not adding `{}` to documentation since no documentation entity could be found for it, not even an empty one.", entity.name()));
       return;
     }
-    root->add_child(*search);
+    root->add_child(search->clone());
 }
 
 void visitor::add_friend(const cppast::cpp_friend& friend_entity) {
@@ -278,13 +278,7 @@ void visitor::add_friend(const cppast::cpp_friend& friend_entity) {
     search->accept(v);
   }
 
-  // We now move the contents of the friended entity to the friend, i.e., we
-  // drop the extra layer created by the friended entity itself.
-  this->root->add_child(root);
-  auto& frend = this->root->rbegin()->as<model::cpp_entity_documentation>();
-  frend.clear();
-  for (auto& child : root)
-    frend.add_child(child);
+  this->root->add_child(std::move(root));
 }
 
 void visitor::add_container(const cppast::cpp_entity& container) {
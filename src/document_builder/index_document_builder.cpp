@@ -47,7 +47,7 @@ document index_document_builder::build(const std::string& name, const std::strin
           // such as the anchor_text_transformation will fill in that text.
           auto link = model::markup::link(target, "");
           
-          list.add_child(model::markup::list_item(link));
+          list.add_child(model::markup::list_item(std::move(link)));
         } else {
           throw std::logic_error("unexpected entity in index document builder");
         }
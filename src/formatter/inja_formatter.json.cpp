@@ -47,13 +47,13 @@ nlohmann::json inja_formatter::to_json(const model::entity& entity) const {
     if constexpr (std::is_same_v<T, model::module>) {
       json["standardese"] = {
         {"kind", "module"},
-        {"name", entity.name },
+        {"name", entity.name.str() },
       };
     } else if constexpr (std::is_same_v<T, model::document>) {
       json["standardese"] = {
         {"kind", "document"},
-        {"name", entity.name},
-        {"path", entity.path},
+        {"name", entity.name.str()},
+        {"path", entity.path.str()},
       };
     } else if constexpr (std::is_same_v<T, model::group_documentation>) {
       json["standardese"] = {
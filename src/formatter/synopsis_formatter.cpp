@@ -48,13 +48,10 @@ model::document synopsis_formatter::build(const model::cpp_entity_documentation&
       }
 
       std::string href = "";
-      // // TODO: Use an inja callback instead and put this reference into some state bag. See the corresponding hack in link_target_transformation.
-      // if (declaration.has_value()) {
-      //   std::stringstream s;
-      //   s << "standardese://@";
-      //   s << (long)&declaration.value() << std::flush;
-      //   href = s.str();
-      // }
+      // TODO: Link to the declaration. Entities must not be encoded in the
+      // URL of a link. Instead, embed a model::link_target for
+      // declaration.value() like the inja_formatter does, so the link is
+      // already resolved when the MarkDown is parsed again.
 
       std::string name{tokens.c_str(), tokens.c_str() + tokens.length()};
       // TODO: Allow certain type replacements here, e.g., mp_limb_signed_t should be long with a tooltip explaining that this is not what it seems.
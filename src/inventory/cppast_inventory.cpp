@@ -9,6 +9,7 @@
 
 #include "../../standardese/inventory/cppast_inventory.hpp"
 #include "../../standardese/inventory/symbols.hpp"
+#include "../../standardese/stats.hpp"
 
 namespace standardese::inventory
 {
@@ -18,6 +19,14 @@ cppast_inventory::cppast_inventory(std::vector<const cppast::cpp_entity*> entiti
       roots.insert(&root(*e));
 }
 
+cppast_inventory::index::~index() {
+  if (hits + misses == 0)
+    return;
+
+  stats::count("link inventory: relative lookup cache hits", hits);
+  stats::count("link inventory: relative lookup cache misses", misses);
+}
+
 const cppast::cpp_file& cppast_inventory::root(const cppast::cpp_entity& entity_) {
   const auto* entity = &entity_;
 
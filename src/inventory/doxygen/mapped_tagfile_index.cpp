@@ -0,0 +1,167 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <fmt/format.h>
+
+#include "../../../standardese/inventory/doxygen/mapped_tagfile_index.hpp"
+#include "../../../standardese/logger.hpp"
+#include "../mapped_inventory.hpp"
+
+namespace standardese::inventory::doxygen {
+
+// The binary format consists of the header, a record for each entity of
+// the index, the hash index of the names, and finally the string table, see
+// mapped_inventory.hpp.
+
+struct mapped_tagfile_index::string {
+  std::uint32_t offset;
+  std::uint32_t length;
+};
+
+struct mapped_tagfile_index::header {
+  /// Bump the version in this magic whenever the format changes.
+  char magic[8];
+
+  /// The hash of the original tagfile.
+  char hash[32];
+
+  std::uint32_t records;
+  std::uint32_t names;
+  std::uint32_t strings;
+};
+
+struct mapped_tagfile_index::record {
+  string name;
+  string filename;
+  string anchor;
+};
+
+struct mapped_tagfile_index::slot {
+  /// One more than the index of the record or zero for an empty slot.
+  std::uint32_t record;
+
+  /// The length of the key which is the name of the record.
+  std::uint32_t length;
+};
+
+namespace {
+
+constexpr char magic[8] = {'S', 'T', 'D', 'S', 'T', 'A', 'G', '1'};
+
+}
+
+mapped_tagfile_index::mapped_tagfile_index(boost::iostreams::mapped_file_source file) : file(std::move(file)) {}
+
+type_safe::optional<mapped_tagfile_index> mapped_tagfile_index::open(const boost::filesystem::path& path, const std::string& hash) {
+  auto file = detail::map<header>(path, magic, hash);
+  if (!file)
+    return type_safe::nullopt;
+
+  mapped_tagfile_index index{std::move(file.value())};
+
+  const auto& head = index.head();
+  const std::size_t size = sizeof(header) + head.records * sizeof(record) + head.names * sizeof(slot) + head.strings;
+  if (index.file.size() != size) {
+    logger::warn(fmt::format("Ignoring truncated cached inventory {}.", path.generic_string()));
+    return type_safe::nullopt;
+  }
+
+  if (!index.valid()) {
+    logger::warn(fmt::format("Ignoring corrupt cached inventory {}.", path.generic_string()));
+    return type_safe::nullopt;
+  }
+
+  return index;
+}
+
+void mapped_tagfile_index::write(const boost::filesystem::path& path, const tagfile_index& index, const std::string& hash) {
+  if (hash.size() > sizeof(header::hash))
+    throw std::invalid_argument("hash of tagfile too long for binary index");
+
+  detail::string_table<string> strings;
+  for (const auto& [name, location] : index) {
+    strings.add(name);
+    strings.add(location.filename);
+    strings.add(location.anchor);
+  }
+
+  const std::string table = strings.build();
+
+  header head{};
+  std::memcpy(head.magic, magic, sizeof(magic));
+  std::memcpy(head.hash, hash.data(), hash.size());
+  head.records = index.size();
+  head.strings = table.size();
+
+  std::vector<record> records;
+  records.reserve(index.size());
+
+  std::unordered_map<std::string_view, slot> names;
+  for (const auto& [name, location] : index) {
+    names.emplace(name, slot{static_cast<std::uint32_t>(records.size()), 0});
+    records.push_back(record{strings[name], strings[location.filename], strings[location.anchor]});
+  }
+
+  const auto name_slots = detail::hash_index(names);
+  head.names = name_slots.size();
+
+  detail::write_atomically(path, [&](std::ostream& out) {
+    out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(record));
+    out.write(reinterpret_cast<const char*>(name_slots.data()), name_slots.size() * sizeof(slot));
+    out.write(table.data(), table.size());
+  });
+}
+
+bool mapped_tagfile_index::valid() const {
+  const auto& head = this->head();
+
+  const auto in_range = [&](const string& value) {
+    return std::uint64_t{value.offset} + value.length <= head.strings;
+  };
+
+  for (std::uint32_t i = 0; i < head.records; i++) {
+    const auto& record = records()[i];
+    for (const auto* value : {&record.name, &record.filename, &record.anchor})
+      if (!in_range(*value))
+        return false;
+  }
+
+  return detail::valid_index(names(), head.names, head.records, [&](std::uint32_t record) { return records()[record].name.length; });
+}
+
+std::size_t mapped_tagfile_index::size() const {
+  return head().records;
+}
+
+type_safe::optional<tagfile_index::location> mapped_tagfile_index::find(std::string_view name) const {
+  const auto* match = detail::probe(names(), head().names, name, [&](const slot& slot) { return str(records()[slot.record - 1].name); });
+  if (match == nullptr)
+    return type_safe::nullopt;
+
+  const auto& record = records()[match->record - 1];
+  return tagfile_index::location{str(record.filename), std::string(str(record.anchor))};
+}
+
+const mapped_tagfile_index::header& mapped_tagfile_index::head() const {
+  return *reinterpret_cast<const header*>(file.data());
+}
+
+const mapped_tagfile_index::record* mapped_tagfile_index::records() const {
+  return reinterpret_cast<const record*>(file.data() + sizeof(header));
+}
+
+const mapped_tagfile_index::slot* mapped_tagfile_index::names() const {
+  return reinterpret_cast<const slot*>(records() + head().records);
+}
+
+std::string_view mapped_tagfile_index::str(const string& value) const {
+  const char* table = reinterpret_cast<const char*>(names() + head().names);
+  return std::string_view(table + value.offset, value.length);
+}
+
+}
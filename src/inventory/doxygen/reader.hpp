@@ -0,0 +1,249 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_INVENTORY_DOXYGEN_READER_HPP_INCLUDED
+#define STANDARDESE_INVENTORY_DOXYGEN_READER_HPP_INCLUDED
+
+#include <cstdlib>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace standardese::inventory::doxygen::detail {
+
+/// A streaming reader for the subset of XML that doxygen writes to tagfiles.
+/// The reader only ever holds the current tag or text in memory so that
+/// even huge tagfiles can be read without building a document tree first.
+class reader {
+ public:
+  enum class event { start, end, text, eof };
+
+  explicit reader(std::istream& in) : in(*in.rdbuf()) {}
+
+  /// Advance to the next start tag, end tag, or non-blank text.
+  /// Comments, processing instructions, and declarations are skipped.
+  event next() {
+    if (closing) {
+      // The current start tag was self-closing like `<docanchor/>`.
+      closing = false;
+      return event::end;
+    }
+
+    while (true) {
+      const int c = in.sgetc();
+      if (c == std::char_traits<char>::eof())
+        return event::eof;
+
+      if (c != '<') {
+        value.clear();
+        while (in.sgetc() != std::char_traits<char>::eof() && in.sgetc() != '<')
+          value += static_cast<char>(in.sbumpc());
+
+        if (value.find_first_not_of(" \t\r\n") == std::string::npos)
+          continue;
+
+        value = decode(value);
+        return event::text;
+      }
+
+      in.sbumpc();
+
+      switch (in.sgetc()) {
+        case '?':
+          skip("?>");
+          continue;
+        case '!':
+          in.sbumpc();
+          if (consume("--")) {
+            skip("-->");
+            continue;
+          }
+          if (consume("[CDATA[")) {
+            value = until("]]>");
+            return event::text;
+          }
+          skip(">");
+          continue;
+        case '/':
+          in.sbumpc();
+          tag = until(">");
+          tag.erase(tag.find_last_not_of(" \t\r\n") + 1);
+          return event::end;
+        default:
+          start();
+          return event::start;
+      }
+    }
+  }
+
+  /// Return the name of the current start or end tag.
+  const std::string& name() const { return tag; }
+
+  /// Return the attribute `key` of the current start tag or an empty string
+  /// if there is no such attribute.
+  std::string attribute(std::string_view key) const {
+    for (const auto& [name, value] : attributes)
+      if (name == key)
+        return value;
+    return "";
+  }
+
+  /// Return the text content of the current element and consume everything
+  /// up to and including its end tag.
+  std::string content() {
+    std::string content;
+    for (int depth = 0;;) {
+      switch (next()) {
+        case event::text:
+          if (depth == 0)
+            content += value;
+          break;
+        case event::start:
+          depth++;
+          break;
+        case event::end:
+          if (depth-- == 0)
+            return content;
+          break;
+        case event::eof:
+          throw std::runtime_error("unexpected end of tagfile");
+      }
+    }
+  }
+
+  /// Consume everything up to and including the end tag of the current
+  /// element.
+  void skip() { content(); }
+
+ private:
+  /// Parse a start tag after its opening `<`.
+  void start() {
+    tag.clear();
+    attributes.clear();
+
+    while (!blank(in.sgetc()) && in.sgetc() != '/' && in.sgetc() != '>' && in.sgetc() != std::char_traits<char>::eof())
+      tag += static_cast<char>(in.sbumpc());
+
+    while (true) {
+      while (blank(in.sgetc()))
+        in.sbumpc();
+
+      const int c = in.sbumpc();
+      if (c == std::char_traits<char>::eof())
+        throw std::runtime_error(fmt::format("unexpected end of tagfile in tag <{}>", tag));
+      if (c == '>')
+        return;
+      if (c == '/') {
+        skip(">");
+        closing = true;
+        return;
+      }
+
+      std::string key(1, static_cast<char>(c));
+      key += until("=");
+      key.erase(key.find_last_not_of(" \t\r\n") + 1);
+
+      while (blank(in.sgetc()))
+        in.sbumpc();
+
+      const char quote = static_cast<char>(in.sbumpc());
+      if (quote != '"' && quote != '\'')
+        throw std::runtime_error(fmt::format("malformed attribute {} in tag <{}>", key, tag));
+
+      attributes.emplace_back(std::move(key), decode(until(std::string_view(&quote, 1))));
+    }
+  }
+
+  static bool blank(int c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+  /// Consume `token` if the input continues with it.
+  /// Only the first character of `token` can be peeked at, so a partial
+  /// match is an error.
+  bool consume(std::string_view token) {
+    if (in.sgetc() != token[0])
+      return false;
+    for (char c : token)
+      if (in.sbumpc() != c)
+        throw std::runtime_error(fmt::format("malformed tagfile, expected `{}`", token));
+    return true;
+  }
+
+  /// Return everything up to `delimiter` and consume the delimiter.
+  std::string until(std::string_view delimiter) {
+    std::string consumed;
+    while (consumed.size() < delimiter.size() || std::string_view(consumed).substr(consumed.size() - delimiter.size()) != delimiter) {
+      const int c = in.sbumpc();
+      if (c == std::char_traits<char>::eof())
+        throw std::runtime_error(fmt::format("unexpected end of tagfile while looking for `{}`", delimiter));
+      consumed += static_cast<char>(c);
+    }
+    consumed.resize(consumed.size() - delimiter.size());
+    return consumed;
+  }
+
+  /// Consume everything up to and including `delimiter`.
+  void skip(std::string_view delimiter) { until(delimiter); }
+
+  /// Return `text` with the XML entities replaced.
+  static std::string decode(const std::string& text) {
+    if (text.find('&') == std::string::npos)
+      return text;
+
+    std::string decoded;
+    for (std::size_t i = 0; i < text.size(); i++) {
+      const auto end = text.find(';', i);
+      if (text[i] != '&' || end == std::string::npos) {
+        decoded += text[i];
+        continue;
+      }
+
+      const auto entity = std::string_view(text).substr(i + 1, end - i - 1);
+      if (entity == "lt") decoded += '<';
+      else if (entity == "gt") decoded += '>';
+      else if (entity == "amp") decoded += '&';
+      else if (entity == "quot") decoded += '"';
+      else if (entity == "apos") decoded += '\'';
+      else if (!entity.empty() && entity[0] == '#') {
+        const bool hex = entity.size() > 1 && (entity[1] == 'x' || entity[1] == 'X');
+        const auto code = std::strtoul(std::string(entity.substr(hex ? 2 : 1)).c_str(), nullptr, hex ? 16 : 10);
+        // Encode the code point as UTF-8.
+        if (code < 0x80) {
+          decoded += static_cast<char>(code);
+        } else if (code < 0x800) {
+          decoded += static_cast<char>(0xc0 | (code >> 6));
+          decoded += static_cast<char>(0x80 | (code & 0x3f));
+        } else if (code < 0x10000) {
+          decoded += static_cast<char>(0xe0 | (code >> 12));
+          decoded += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+          decoded += static_cast<char>(0x80 | (code & 0x3f));
+        } else {
+          decoded += static_cast<char>(0xf0 | (code >> 18));
+          decoded += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+          decoded += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+          decoded += static_cast<char>(0x80 | (code & 0x3f));
+        }
+      } else {
+        decoded += text.substr(i, end - i + 1);
+      }
+      i = end;
+    }
+    return decoded;
+  }
+
+  std::streambuf& in;
+
+  std::string tag;
+  std::vector<std::pair<std::string, std::string>> attributes;
+  std::string value;
+  bool closing = false;
+};
+
+}
+
+#endif
@@ -0,0 +1,228 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "../../../standardese/inventory/doxygen/tagfile.hpp"
+#include "reader.hpp"
+
+namespace standardese::inventory::doxygen {
+
+namespace {
+
+using detail::reader;
+
+anchor read_anchor(reader& xml) {
+  anchor anchor;
+  anchor.filename = xml.attribute("file");
+  anchor.title = xml.attribute("title");
+  anchor.label = xml.content();
+  return anchor;
+}
+
+tagfile::member read_member(reader& xml) {
+  tagfile::member member;
+  member.kind = xml.attribute("kind");
+  if (const auto protection = xml.attribute("protection"); !protection.empty())
+    member.protection = protection;
+  if (const auto virt = xml.attribute("virtualness"); !virt.empty())
+    member.virt = virt;
+  member.is_static = xml.attribute("static") == "yes";
+
+  for (auto event = xml.next(); event != reader::event::end; event = xml.next()) {
+    if (event == reader::event::eof)
+      throw std::runtime_error("unexpected end of tagfile in <member>");
+    if (event != reader::event::start)
+      continue;
+
+    const auto name = xml.name();
+    if (name == "type") member.type = xml.content();
+    else if (name == "name") member.name = xml.content();
+    else if (name == "anchorfile") member.anchor_file = xml.content();
+    else if (name == "anchor") member.anchor = xml.content();
+    else if (name == "arglist") member.args = xml.content();
+    else if (name == "clangid") member.clang_id = xml.content();
+    else if (name == "docanchor") member.anchors.push_back(read_anchor(xml));
+    else if (name == "enumvalue") {
+      tagfile::enum_value value;
+      value.file = xml.attribute("file");
+      value.anchor = xml.attribute("anchor");
+      value.clang_id = xml.attribute("clangid");
+      value.name = xml.content();
+      member.enum_values.push_back(std::move(value));
+    } else xml.skip();
+  }
+
+  return member;
+}
+
+// The elements that only some kinds of compounds have. Each of these returns
+// whether it consumed the current element.
+
+bool read_element(reader& xml, tagfile::type& type) {
+  const auto name = xml.name();
+  if (name == "anchor") type.anchor = xml.content();
+  else if (name == "clangid") type.clang_id = xml.content();
+  else if (name == "base") type.bases.push_back(xml.content());
+  else if (name == "templarg") type.template_args.push_back(xml.content());
+  else if (name == "class") type.classes.push_back(xml.content());
+  else return false;
+  return true;
+}
+
+bool read_element(reader& xml, tagfile::concept& concept) {
+  if (xml.name() != "clangid")
+    return false;
+  concept.clang_id = xml.content();
+  return true;
+}
+
+bool read_element(reader& xml, tagfile::namespase& namespase) {
+  const auto name = xml.name();
+  if (name == "clangid") namespase.clangId = xml.content();
+  else if (name == "class") namespase.classes.push_back(xml.content());
+  else if (name == "concept") namespase.concepts.push_back(xml.content());
+  else if (name == "namespace") namespase.namespaces.push_back(xml.content());
+  else return false;
+  return true;
+}
+
+bool read_element(reader& xml, tagfile::package& package) {
+  if (xml.name() != "class")
+    return false;
+  package.classes.push_back(xml.content());
+  return true;
+}
+
+bool read_element(reader& xml, tagfile::file& file) {
+  const auto name = xml.name();
+  if (name == "path") file.path = xml.content();
+  else if (name == "class") file.classes.push_back(xml.content());
+  else if (name == "concept") file.concepts.push_back(xml.content());
+  else if (name == "namespace") file.namespaces.push_back(xml.content());
+  else if (name == "includes") {
+    tagfile::include include;
+    include.id = xml.attribute("id");
+    include.name = xml.attribute("name");
+    include.isLocal = xml.attribute("local") == "yes";
+    include.isImported = xml.attribute("imported") == "yes";
+    include.text = xml.content();
+    file.includes.push_back(std::move(include));
+  } else return false;
+  return true;
+}
+
+bool read_element(reader& xml, tagfile::group& group) {
+  const auto name = xml.name();
+  if (name == "title") group.title = xml.content();
+  else if (name == "subgroup") group.subgroups.push_back(xml.content());
+  else if (name == "class") group.classes.push_back(xml.content());
+  else if (name == "concept") group.concepts.push_back(xml.content());
+  else if (name == "namespace") group.namespaces.push_back(xml.content());
+  else if (name == "file") group.files.push_back(xml.content());
+  else if (name == "page") group.pages.push_back(xml.content());
+  else if (name == "dir") group.directories.push_back(xml.content());
+  else return false;
+  return true;
+}
+
+bool read_element(reader& xml, tagfile::page& page) {
+  if (xml.name() != "title")
+    return false;
+  page.title = xml.content();
+  return true;
+}
+
+bool read_element(reader& xml, tagfile::directory& directory) {
+  const auto name = xml.name();
+  if (name == "path") directory.path = xml.content();
+  else if (name == "dir") directory.subdirectories.push_back(xml.content());
+  else if (name == "file") directory.files.push_back(xml.content());
+  else return false;
+  return true;
+}
+
+/// Read the children of the current `<compound>` element into `compound`.
+template <typename T>
+void read_compound(reader& xml, T& compound) {
+  for (auto event = xml.next(); event != reader::event::end; event = xml.next()) {
+    if (event == reader::event::eof)
+      throw std::runtime_error("unexpected end of tagfile in <compound>");
+    if (event != reader::event::start)
+      continue;
+
+    const auto name = xml.name();
+    if (name == "name") compound.name = xml.content();
+    else if (name == "filename") compound.filename = xml.content();
+    else if (name == "docanchor") compound.anchors.push_back(read_anchor(xml));
+    else if (name == "member") compound.members.push_back(read_member(xml));
+    else if (!read_element(xml, compound)) xml.skip();
+  }
+}
+
+}
+
+tagfile tagfile::parse(const std::string& fname) {
+  std::ifstream in(fname);
+  if (!in)
+    throw std::invalid_argument(fmt::format("Could not open tagfile {}.", fname));
+
+  tagfile tagfile;
+  in >> tagfile;
+  return tagfile;
+}
+
+std::istream& operator>>(std::istream& in, tagfile& tagfile) {
+  if (in.rdbuf() == nullptr)
+    throw std::invalid_argument("Cannot read tagfile from a stream without buffer.");
+
+  reader xml(in);
+
+  for (auto event = xml.next(); event != reader::event::eof; event = xml.next()) {
+    if (event != reader::event::start)
+      continue;
+
+    if (xml.name() == "tagfile")
+      // Descend into the top-level element.
+      continue;
+
+    if (xml.name() != "compound") {
+      xml.skip();
+      continue;
+    }
+
+    const auto kind = xml.attribute("kind");
+    if (kind == "class" || kind == "struct" || kind == "union" || kind == "interface" || kind == "protocol" || kind == "category" || kind == "exception" || kind == "service" || kind == "singleton") {
+      auto& type = tagfile.types.emplace_back();
+      type.kind = kind;
+      type.is_obj_c = xml.attribute("objc") == "yes";
+      read_compound(xml, type);
+    } else if (kind == "concept") {
+      read_compound(xml, tagfile.concepts.emplace_back());
+    } else if (kind == "namespace") {
+      read_compound(xml, tagfile.namespaces.emplace_back());
+    } else if (kind == "package") {
+      read_compound(xml, tagfile.packages.emplace_back());
+    } else if (kind == "file") {
+      read_compound(xml, tagfile.files.emplace_back());
+    } else if (kind == "group") {
+      read_compound(xml, tagfile.groups.emplace_back());
+    } else if (kind == "page") {
+      read_compound(xml, tagfile.pages.emplace_back());
+    } else if (kind == "dir") {
+      read_compound(xml, tagfile.directories.emplace_back());
+    } else {
+      xml.skip();
+    }
+  }
+
+  return in;
+}
+
+}
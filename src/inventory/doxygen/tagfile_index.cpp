@@ -0,0 +1,169 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../../../standardese/inventory/doxygen/tagfile_index.hpp"
+#include "reader.hpp"
+
+namespace standardese::inventory::doxygen {
+
+namespace {
+
+using detail::reader;
+
+/// An entity of a compound whose name is relative to that compound.
+struct relative {
+  std::string name;
+
+  /// The page of the entity or empty if it is the page of its compound.
+  std::string filename;
+
+  std::string anchor;
+};
+
+/// Read the current `<member>` element and append it to `members`.
+void read_member(reader& xml, std::vector<relative>& members) {
+  relative member;
+  std::vector<relative> values;
+
+  for (auto event = xml.next(); event != reader::event::end; event = xml.next()) {
+    if (event == reader::event::eof)
+      throw std::runtime_error("unexpected end of tagfile in <member>");
+    if (event != reader::event::start)
+      continue;
+
+    const auto name = xml.name();
+    if (name == "name") member.name = xml.content();
+    else if (name == "anchorfile") member.filename = xml.content();
+    else if (name == "anchor") member.anchor = xml.content();
+    else if (name == "enumvalue") {
+      relative value;
+      value.filename = xml.attribute("file");
+      value.anchor = xml.attribute("anchor");
+      value.name = xml.content();
+      values.push_back(std::move(value));
+    } else xml.skip();
+  }
+
+  members.push_back(member);
+
+  // The values of an enum can be named with and without the name of the
+  // enum itself.
+  for (auto& value : values) {
+    if (value.filename.empty())
+      value.filename = member.filename;
+    members.push_back({member.name + "::" + value.name, value.filename, value.anchor});
+    members.push_back(std::move(value));
+  }
+}
+
+/// Read the children of the current `<compound>` element and record the
+/// compound and its members in `index`. Members of files are members of the
+/// global namespace.
+void read_compound(reader& xml, tagfile_index& index, bool file) {
+  std::string name;
+  std::string filename;
+  std::vector<relative> members;
+
+  for (auto event = xml.next(); event != reader::event::end; event = xml.next()) {
+    if (event == reader::event::eof)
+      throw std::runtime_error("unexpected end of tagfile in <compound>");
+    if (event != reader::event::start)
+      continue;
+
+    const auto element = xml.name();
+    if (element == "name") name = xml.content();
+    else if (element == "filename") filename = xml.content();
+    else if (element == "member") read_member(xml, members);
+    else xml.skip();
+  }
+
+  const std::string scope = file ? "" : name + "::";
+
+  index.add(std::move(name), filename, "");
+  for (auto& member : members)
+    index.add(scope + member.name, member.filename.empty() ? filename : member.filename, std::move(member.anchor));
+}
+
+}
+
+tagfile_index tagfile_index::parse(const std::string& fname) {
+  std::ifstream in(fname);
+  if (!in)
+    throw std::invalid_argument(fmt::format("Could not open tagfile {}.", fname));
+
+  tagfile_index index;
+  in >> index;
+  return index;
+}
+
+std::istream& operator>>(std::istream& in, tagfile_index& index) {
+  if (in.rdbuf() == nullptr)
+    throw std::invalid_argument("Cannot read tagfile from a stream without buffer.");
+
+  reader xml(in);
+
+  for (auto event = xml.next(); event != reader::event::eof; event = xml.next()) {
+    if (event != reader::event::start)
+      continue;
+
+    if (xml.name() == "tagfile")
+      // Descend into the top-level element.
+      continue;
+
+    if (xml.name() != "compound") {
+      xml.skip();
+      continue;
+    }
+
+    // Only the compounds that correspond to C++ entities can be linked to.
+    // Groups, pages, and directories only organize the documentation.
+    const auto kind = xml.attribute("kind");
+    if (kind == "class" || kind == "struct" || kind == "union" || kind == "interface" || kind == "protocol" || kind == "category" || kind == "exception" || kind == "service" || kind == "singleton" || kind == "concept" || kind == "namespace")
+      read_compound(xml, index, false);
+    else if (kind == "file")
+      read_compound(xml, index, true);
+    else
+      xml.skip();
+  }
+
+  return in;
+}
+
+void tagfile_index::add(std::string name, std::string_view filename, std::string anchor) {
+  if (names.count(name))
+    return;
+
+  const auto& page = *pages.emplace(filename).first;
+  names.emplace(std::move(name), location{page, std::move(anchor)});
+}
+
+type_safe::optional_ref<const tagfile_index::location> tagfile_index::find(const std::string& name) const {
+  const auto match = names.find(name);
+  if (match == names.end())
+    return type_safe::nullopt;
+  return type_safe::ref(match->second);
+}
+
+std::size_t tagfile_index::size() const {
+  return names.size();
+}
+
+std::size_t tagfile_index::memory() const {
+  std::size_t memory = (pages.bucket_count() + names.bucket_count()) * sizeof(void*);
+  for (const auto& page : pages)
+    memory += sizeof(page) + page.capacity() + sizeof(void*);
+  for (const auto& [name, location] : names)
+    memory += sizeof(name) + name.capacity() + sizeof(location) + location.anchor.capacity() + sizeof(void*);
+  return memory;
+}
+
+}
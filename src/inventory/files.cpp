@@ -9,20 +9,66 @@
 #include <type_safe/optional.hpp>
 
 #include "../../standardese/inventory/files.hpp"
+#include "../../standardese/inventory/cppast_inventory.hpp"
 
 namespace standardese::inventory {
 
-files::files(const std::vector<const cppast::cpp_file*>& headers): headers(begin(headers), end(headers)) {}
+namespace {
+
+/// Return `path` made absolute relative to `base` without any `.` or `..`.
+/// This does not touch the file system, so symlinks are not resolved.
+boost::filesystem::path normalize(const boost::filesystem::path& path, const boost::filesystem::path& base) {
+  return boost::filesystem::absolute(path, base).lexically_normal();
+}
+
+}
+
+files::files(const std::vector<const cppast::cpp_file*>& headers) : working_directory(boost::filesystem::current_path()) {
+  for (const auto* header : headers) {
+    const auto path = normalize(header->name(), working_directory);
+
+    paths.emplace(path.generic_string(), header);
+
+    // Index all the trailing parts of the path, e.g., `c.hpp`, `b/c.hpp`,
+    // and `a/b/c.hpp` for `/a/b/c.hpp`. If several headers share such a
+    // suffix, the first one wins.
+    std::string suffix;
+    for (auto component = path.end(); component != path.begin();) {
+      --component;
+      if (component->has_root_name() || component->has_root_directory())
+        break;
+
+      suffix = suffix.empty() ? component->generic_string() : component->generic_string() + "/" + suffix;
+      suffixes.emplace(suffix, header);
+    }
+  }
+}
 
 type_safe::optional_ref<const cppast::cpp_file> files::find_header(const std::string& name) const {
-  return find_header(name, boost::filesystem::current_path().native());
+  return find_header(name, working_directory.generic_string());
+}
+
+type_safe::optional_ref<const cppast::cpp_file> files::find_header(const std::string& name, const cppast::cpp_entity& entity) const {
+  const auto& file = cppast_inventory::root(entity);
+  return find_header(name, normalize(file.name(), working_directory).parent_path().generic_string());
 }
 
 type_safe::optional_ref<const cppast::cpp_file> files::find_header(const std::string& name, const std::string& path) const {
-  // TODO: Make this lookup more flexible.
-  for (const auto* header : headers) {
-    if (boost::filesystem::path(header->name()).filename() == boost::filesystem::path(name).filename())
-      return type_safe::ref(*header);
+  if (name.empty())
+    return type_safe::nullopt;
+
+  const auto exact = paths.find(normalize(name, path).generic_string());
+  if (exact != paths.end())
+    return type_safe::ref(*exact->second);
+
+  // There is no such header relative to `path`. Return any header ending
+  // in `name`, or failing that, any header with the same file name.
+  const auto relative = boost::filesystem::path(name).lexically_normal();
+
+  for (const auto& suffix : {relative.generic_string(), relative.filename().generic_string()}) {
+    const auto match = suffixes.find(suffix);
+    if (match != suffixes.end())
+      return type_safe::ref(*match->second);
   }
 
   return type_safe::nullopt;
@@ -0,0 +1,178 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_INVENTORY_MAPPED_INVENTORY_HPP_INCLUDED
+#define STANDARDESE_INVENTORY_MAPPED_INVENTORY_HPP_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <fmt/format.h>
+#include <type_safe/optional.hpp>
+
+#include "../../standardese/logger.hpp"
+
+// The building blocks of the binary inventories that are memory mapped from
+// disk, see [sphinx::mapped_documentation_set]() and
+// [doxygen::mapped_tagfile_index]().
+// Such a file consists of a header, fixed size records, open addressing hash
+// indexes with linear probing, and finally the sorted table of all the
+// distinct strings. Since the file is only ever read on the machine that
+// wrote it, all integers are stored in native byte order.
+namespace standardese::inventory::detail {
+
+/// Return the hash of `value` that the hash indexes are probed with.
+inline std::uint64_t hash(std::string_view value) {
+  // 64-bit FNV-1a
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  for (char c : value) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+/// The distinct strings of a binary inventory in sorted order. Each string
+/// is referred to by a `String` of its `offset` and `length` in the table.
+template <typename String>
+class string_table {
+ public:
+  /// Record that `value` needs to be in the table.
+  void add(std::string_view value) { strings[value]; }
+
+  /// Lay out the recorded strings and return the table.
+  std::string build() {
+    std::string table;
+    for (auto& [value, location] : strings) {
+      location = String{static_cast<std::uint32_t>(table.size()), static_cast<std::uint32_t>(value.size())};
+      table += value;
+    }
+    return table;
+  }
+
+  /// Return where `value` is in the table that has been built.
+  String operator[](std::string_view value) const { return strings.at(value); }
+
+ private:
+  std::map<std::string_view, String> strings;
+};
+
+/// Return a hash index for the `keys`. The `record` of each slot is made one
+/// based so that zero marks an empty slot, and its `length` is set to the
+/// length of the key.
+template <typename Slot>
+std::vector<Slot> hash_index(const std::unordered_map<std::string_view, Slot>& keys) {
+  std::uint32_t capacity = 1;
+  while (capacity < 2 * keys.size())
+    capacity *= 2;
+
+  std::vector<Slot> slots(capacity, Slot{});
+  for (const auto& [key, value] : keys) {
+    auto position = hash(key) & (slots.size() - 1);
+    while (slots[position].record != 0)
+      position = (position + 1) & (slots.size() - 1);
+    slots[position] = value;
+    slots[position].record = value.record + 1;
+    slots[position].length = static_cast<std::uint32_t>(key.size());
+  }
+  return slots;
+}
+
+/// Return the slot in the hash index `slots` of size `count` whose key is
+/// `name` or `nullptr` if there is no such slot. The key of a slot is the
+/// trailing part of length `length` of what `name_of` returns for it.
+template <typename Slot, typename Name>
+const Slot* probe(const Slot* slots, std::uint32_t count, std::string_view name, Name&& name_of) {
+  if (count == 0)
+    return nullptr;
+
+  for (auto position = hash(name) & (count - 1); slots[position].record != 0; position = (position + 1) & (count - 1)) {
+    const auto& slot = slots[position];
+    if (slot.length != name.size())
+      continue;
+
+    const std::string_view key = name_of(slot);
+    if (key.substr(key.size() - slot.length) == name)
+      return &slot;
+  }
+
+  return nullptr;
+}
+
+/// Return whether the hash index `slots` of size `count` only refers to
+/// existing records and to keys that fit into the names of their records.
+template <typename Slot, typename Length>
+bool valid_index(const Slot* slots, std::uint32_t count, std::uint32_t records, Length&& length_of) {
+  // The hash indexes are probed modulo their size.
+  if (count & (count - 1))
+    return false;
+
+  for (std::uint32_t i = 0; i < count; i++) {
+    if (slots[i].record == 0)
+      continue;
+    if (slots[i].record > records || slots[i].length > length_of(slots[i].record - 1))
+      return false;
+  }
+  return true;
+}
+
+/// Map the binary inventory at `path` if it is at least as large as the
+/// header `Header`, starts with `magic`, and has been written for contents
+/// with the `hash`.
+template <typename Header>
+type_safe::optional<boost::iostreams::mapped_file_source> map(const boost::filesystem::path& path, const char (&magic)[8], const std::string& hash) {
+  if (!boost::filesystem::exists(path) || boost::filesystem::file_size(path) < sizeof(Header))
+    return type_safe::nullopt;
+
+  boost::iostreams::mapped_file_source file;
+  try {
+    file.open(path.native());
+  } catch (std::exception& e) {
+    logger::warn(fmt::format("Could not map cached inventory {}: {}", path.generic_string(), e.what()));
+    return type_safe::nullopt;
+  }
+
+  const auto& head = *reinterpret_cast<const Header*>(file.data());
+  if (std::memcmp(head.magic, magic, sizeof(magic)) != 0)
+    return type_safe::nullopt;
+
+  if (std::string_view(head.hash, strnlen(head.hash, sizeof(head.hash))) != hash)
+    return type_safe::nullopt;
+
+  return file;
+}
+
+/// Write the binary inventory at `path` by calling `write` with a stream.
+/// The inventory is written to a temporary file first so that concurrent
+/// runs never map a partially written file.
+template <typename F>
+void write_atomically(const boost::filesystem::path& path, F&& write) {
+  boost::filesystem::create_directories(path.parent_path());
+
+  const auto temporary = path.parent_path() / boost::filesystem::unique_path(path.filename().native() + ".%%%%-%%%%");
+  {
+    std::ofstream out(temporary.native(), std::ios::binary);
+    write(out);
+
+    if (!out) {
+      logger::warn(fmt::format("Could not write cached inventory {}.", path.generic_string()));
+      boost::system::error_code ec;
+      boost::filesystem::remove(temporary, ec);
+      return;
+    }
+  }
+
+  boost::filesystem::rename(temporary, path);
+}
+
+}
+
+#endif
@@ -2,10 +2,15 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <cctype>
+#include <cstdlib>
 #include <iostream>
+#include <optional>
 #include <fstream>
 #include <sstream>
-#include <regex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
 
 #include <fmt/format.h>
 #include <boost/iostreams/filtering_streambuf.hpp>
@@ -84,6 +89,69 @@ void load_v1(std::istream& in, documentation_set& inventory) {
   throw std::logic_error("not implemented: loading of Sphinx version 1 inventories"); 
 }
 
+/// The fields of a line in the compressed part of a Sphinx inventory.
+struct line {
+  std::string_view name;
+  std::string_view type;
+  long priority;
+  std::string_view location;
+  std::string_view display_name;
+};
+
+bool is_space(char c) {
+  return std::isspace(static_cast<unsigned char>(c));
+}
+
+/// Split `text` into the fields of a line in an inventory.
+/// This is equivalent to the regular expression
+/// `(.+?)\s+(\S+)\s+(-?\d+)\s+?(\S*)\s+(.*)` that Sphinx matches against
+/// the line without trailing whitespace, see
+/// https://github.com/sphinx-doc/sphinx/blob/4.x/sphinx/util/inventory.py#L123
+std::optional<line> tokenize(std::string_view text) {
+  // Drop the \r of lines that end in \r\n, and any other trailing space.
+  while (!text.empty() && is_space(text.back()))
+    text.remove_suffix(1);
+
+  // The name can contain spaces, so we try all the whitespace runs as the
+  // end of the name until the remainder of the line can be parsed.
+  for (std::size_t end = 1; end < text.size(); end++) {
+    if (!is_space(text[end]) || (end > 1 && is_space(text[end - 1])))
+      continue;
+
+    auto position = end;
+    const auto skip = [&](bool space) {
+      const auto start = position;
+      while (position < text.size() && is_space(text[position]) == space)
+        position++;
+      return text.substr(start, position - start);
+    };
+
+    skip(true);
+
+    const auto type = skip(false);
+    if (type.empty() || skip(true).empty())
+      continue;
+
+    const auto priority = skip(false);
+    if (priority.empty() || priority == "-" || priority.find_first_not_of("0123456789", priority[0] == '-' ? 1 : 0) != std::string_view::npos)
+      continue;
+
+    // The location is separated from the priority by exactly one space. It
+    // might be empty.
+    if (position == text.size())
+      continue;
+    position++;
+
+    const auto location = skip(false);
+    if (skip(true).empty())
+      continue;
+
+    return line{text.substr(0, end), type, std::strtol(std::string(priority).c_str(), nullptr, 10), location, text.substr(position)};
+  }
+
+  return std::nullopt;
+}
+
 // See https://github.com/sphinx-doc/sphinx/blob/4.x/sphinx/util/inventory.py#L113
 void load_v2(std::istream& in, documentation_set& inventory) {
   std::getline(in, inventory.project);
@@ -96,61 +164,74 @@ void load_v2(std::istream& in, documentation_set& inventory) {
   std::string header;
   std::getline(in, header);
 
-  static std::regex zlib{"zlib"};
-  if (!std::regex_search(header, zlib))
+  if (header.find("zlib") == std::string::npos)
     throw std::invalid_argument("invalid sphinx inventory header (not compressed)");
 
-  boost::iostreams::filtering_streambuf<boost::iostreams::input> compressed;
-  compressed.push(boost::iostreams::zlib_decompressor());
-  compressed.push(in);
-
-  std::stringstream uncompressed;
-
-  boost::iostreams::copy(compressed, uncompressed);
+  // The names of the py:module entries, see below.
+  std::unordered_set<std::string> modules;
 
-  while(!uncompressed.eof()) {
-    std::string line;
-    std::getline(uncompressed, line);
+  const auto parse = [&](std::string_view text) {
+    const auto line = tokenize(text);
 
-    // Essentially the same as https://github.com/sphinx-doc/sphinx/blob/4.x/sphinx/util/inventory.py#L123
-    static std::regex syntax{R"((.+?)\s+(\S+)\s+(-?\d+)\s+?(\S*)\s+(.*)\s*)"};
-    std::smatch match;
-
-    if (!std::regex_match(line, match, syntax)) {
+    if (!line) {
       // Apparently, non-matching lines are allowed: https://github.com/sphinx-doc/sphinx/blob/4.x/sphinx/util/inventory.py#L126
-      logger::info(fmt::format("Ignoring malformed line in Sphinx inventory: `{}`", line));
-      continue;
+      if (!text.empty())
+        logger::info([&]() { return fmt::format("Ignoring malformed line in Sphinx inventory: `{}`", text); });
+      return;
     }
 
-    assert(match.size() == 6);
-
-    std::string name = match[1].str();
-    std::string type = match[2].str();
-    std::string prio = match[3].str();
-    std::string location = match[4].str();
-    std::string dispname = match[5].str();
-
-    if (type.find(':') == std::string::npos) {
+    const auto separator = line->type.find(':');
+    if (separator == std::string_view::npos) {
       // Incorrectly formatted types are ignored: https://github.com/sphinx-doc/sphinx/blob/4.x/sphinx/util/inventory.py#L128
-      logger::info(fmt::format("Ignoring malformed domain:type in Sphinx inventory: `{}`", type));
-      continue;
+      logger::info([&]() { return fmt::format("Ignoring malformed domain:type in Sphinx inventory: `{}`", line->type); });
+      return;
     }
 
-    std::string domain = type.substr(0, type.find(':'));
+    std::string name{line->name};
 
-    if (type == "py:module") {
+    if (line->type == "py:module") {
       // Work around a bug in Sphinx 1.1, see https://github.com/sphinx-doc/sphinx/blob/4.x/sphinx/util/inventory.py#L133
-      if (std::find_if(begin(inventory.entries), end(inventory.entries), [&](const auto& entry) { return entry.name == name; }) != end(inventory.entries))
-        continue;
+      if (!modules.insert(name).second)
+        return;
     }
 
-    type = type.substr(type.find(':') + 1);
-
-    if (location.size() && location[location.size() - 1] == '$')
+    std::string location{line->location};
+    if (location.size() && location.back() == '$')
       location = location.substr(0, location.size() - 1) + name;
 
-    inventory.entries.emplace_back(name, domain, type, atol(prio.c_str()), location, dispname);
+    inventory.entries.emplace_back(std::move(name), std::string(line->type.substr(0, separator)), std::string(line->type.substr(separator + 1)), line->priority, std::move(location), std::string(line->display_name));
+  };
+
+  boost::iostreams::filtering_streambuf<boost::iostreams::input> decompressed;
+  decompressed.push(boost::iostreams::zlib_decompressor());
+  decompressed.push(in);
+
+  std::istream uncompressed(&decompressed);
+
+  // Inflate the inventory in chunks and parse all the complete lines in each
+  // chunk directly. Only lines that span several chunks need to be copied.
+  std::vector<char> buffer(1 << 16);
+  std::string partial;
+
+  while (uncompressed.read(buffer.data(), buffer.size()) || uncompressed.gcount()) {
+    const std::string_view chunk(buffer.data(), uncompressed.gcount());
+
+    std::size_t start = 0;
+    for (auto end = chunk.find('\n'); end != std::string_view::npos; end = chunk.find('\n', start)) {
+      if (partial.empty()) {
+        parse(chunk.substr(start, end - start));
+      } else {
+        partial.append(chunk.substr(start, end - start));
+        parse(partial);
+        partial.clear();
+      }
+      start = end + 1;
+    }
+
+    partial.append(chunk.substr(start));
   }
+
+  parse(partial);
 }
 
 }
@@ -0,0 +1,242 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <fmt/format.h>
+
+#include "../../../standardese/inventory/sphinx/mapped_documentation_set.hpp"
+#include "../../../standardese/inventory/sphinx/documentation_set.hpp"
+#include "../../../standardese/logger.hpp"
+#include "../mapped_inventory.hpp"
+
+namespace standardese::inventory::sphinx {
+
+// The binary format consists of the header, the records in the order of
+// the entries of the original inventory, the hash index of the names, the
+// hash index of the suffixes of names, and finally the string table, see
+// mapped_inventory.hpp.
+
+struct mapped_documentation_set::string {
+  std::uint32_t offset;
+  std::uint32_t length;
+};
+
+struct mapped_documentation_set::header {
+  /// Bump the version in this magic whenever the format changes.
+  char magic[8];
+
+  /// The hash of the original intersphinx inventory.
+  char hash[32];
+
+  std::uint32_t records;
+  std::uint32_t names;
+  std::uint32_t suffixes;
+  std::uint32_t strings;
+
+  string project;
+  string version;
+};
+
+struct mapped_documentation_set::record {
+  string name;
+  string domain;
+  string type;
+  string uri;
+  string display_name;
+  std::int64_t priority;
+};
+
+struct mapped_documentation_set::slot {
+  /// One more than the index of the record or zero for an empty slot.
+  std::uint32_t record;
+
+  /// The length of the key which is the trailing part of the record's name.
+  std::uint32_t length;
+
+  /// Whether several records with the same best priority have this key.
+  std::uint32_t ambiguous;
+};
+
+namespace {
+
+constexpr char magic[8] = {'S', 'T', 'D', 'S', 'I', 'N', 'V', '1'};
+
+}
+
+mapped_documentation_set::mapped_documentation_set(boost::iostreams::mapped_file_source file) : file(std::move(file)) {}
+
+type_safe::optional<mapped_documentation_set> mapped_documentation_set::open(const boost::filesystem::path& path, const std::string& hash) {
+  auto file = detail::map<header>(path, magic, hash);
+  if (!file)
+    return type_safe::nullopt;
+
+  mapped_documentation_set inventory{std::move(file.value())};
+
+  const auto& head = inventory.head();
+  const std::size_t size = sizeof(header) + head.records * sizeof(record) + (head.names + head.suffixes) * sizeof(slot) + head.strings;
+  if (inventory.file.size() != size) {
+    logger::warn(fmt::format("Ignoring truncated cached inventory {}.", path.generic_string()));
+    return type_safe::nullopt;
+  }
+
+  if (!inventory.valid()) {
+    logger::warn(fmt::format("Ignoring corrupt cached inventory {}.", path.generic_string()));
+    return type_safe::nullopt;
+  }
+
+  return inventory;
+}
+
+void mapped_documentation_set::write(const boost::filesystem::path& path, const documentation_set& inventory, const std::string& hash) {
+  if (hash.size() > sizeof(header::hash))
+    throw std::invalid_argument("hash of inventory too long for binary inventory");
+
+  detail::string_table<string> strings;
+  strings.add(inventory.project);
+  strings.add(inventory.version);
+  for (const auto& entry : inventory.entries)
+    for (const auto* value : {&entry.name, &entry.domain, &entry.type, &entry.uri, &entry.display_name})
+      strings.add(*value);
+
+  const std::string table = strings.build();
+
+  header head{};
+  std::memcpy(head.magic, magic, sizeof(magic));
+  std::memcpy(head.hash, hash.data(), hash.size());
+  head.records = inventory.entries.size();
+  head.strings = table.size();
+  head.project = strings[inventory.project];
+  head.version = strings[inventory.version];
+
+  std::vector<record> records;
+  records.reserve(inventory.entries.size());
+  for (const auto& entry : inventory.entries)
+    records.push_back(record{strings[entry.name], strings[entry.domain], strings[entry.type], strings[entry.uri], strings[entry.display_name], entry.priority});
+
+  // Determine the record with the best priority for each name and for each
+  // suffix of a name, with the same rules as the symbols for a
+  // documentation_set.
+  const auto preferred = [&](std::uint32_t candidate, std::uint32_t current) {
+    return inventory.entries[candidate].priority < inventory.entries[current].priority;
+  };
+
+  std::unordered_map<std::string_view, slot> names;
+  std::unordered_map<std::string_view, slot> suffixes;
+  for (std::uint32_t entry = 0; entry < inventory.entries.size(); entry++) {
+    const std::string_view name = inventory.entries[entry].name;
+
+    const auto [best, inserted] = names.emplace(name, slot{entry, 0, false});
+    if (!inserted && preferred(entry, best->second.record))
+      best->second.record = entry;
+
+    for_each_suffix(name, [&](std::string_view suffix) {
+      const auto [match, inserted] = suffixes.emplace(suffix, slot{entry, 0, false});
+      if (inserted || match->second.record == entry)
+        return;
+
+      if (preferred(entry, match->second.record))
+        match->second = slot{entry, 0, false};
+      else if (!preferred(match->second.record, entry))
+        match->second.ambiguous = true;
+    });
+  }
+
+  const auto name_slots = detail::hash_index(names);
+  const auto suffix_slots = detail::hash_index(suffixes);
+
+  head.names = name_slots.size();
+  head.suffixes = suffix_slots.size();
+
+  detail::write_atomically(path, [&](std::ostream& out) {
+    out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(record));
+    out.write(reinterpret_cast<const char*>(name_slots.data()), name_slots.size() * sizeof(slot));
+    out.write(reinterpret_cast<const char*>(suffix_slots.data()), suffix_slots.size() * sizeof(slot));
+    out.write(table.data(), table.size());
+  });
+}
+
+bool mapped_documentation_set::valid() const {
+  const auto& head = this->head();
+
+  const auto in_range = [&](const string& value) {
+    return std::uint64_t{value.offset} + value.length <= head.strings;
+  };
+
+  if (!in_range(head.project) || !in_range(head.version))
+    return false;
+
+  for (std::uint32_t i = 0; i < head.records; i++) {
+    const auto& record = records()[i];
+    for (const auto* value : {&record.name, &record.domain, &record.type, &record.uri, &record.display_name})
+      if (!in_range(*value))
+        return false;
+  }
+
+  // Every key must be a trailing part of the name of its record.
+  const auto length = [&](std::uint32_t record) { return records()[record].name.length; };
+
+  return detail::valid_index(names(), head.names, head.records, length) && detail::valid_index(suffixes(), head.suffixes, head.records, length);
+}
+
+std::string_view mapped_documentation_set::project() const {
+  return str(head().project);
+}
+
+std::string_view mapped_documentation_set::version() const {
+  return str(head().version);
+}
+
+std::size_t mapped_documentation_set::size() const {
+  return head().records;
+}
+
+type_safe::optional<entry> mapped_documentation_set::find(std::string_view name) const {
+  const auto* match = probe(names(), head().names, name);
+  if (match == nullptr)
+    return type_safe::nullopt;
+
+  return materialize(records()[match->record - 1]);
+}
+
+type_safe::optional<entry> mapped_documentation_set::find_suffix(std::string_view name) const {
+  const auto* match = probe(suffixes(), head().suffixes, name);
+  if (match == nullptr || match->ambiguous)
+    return type_safe::nullopt;
+
+  return materialize(records()[match->record - 1]);
+}
+
+const mapped_documentation_set::header& mapped_documentation_set::head() const {
+  return *reinterpret_cast<const header*>(file.data());
+}
+
+const mapped_documentation_set::record* mapped_documentation_set::records() const {
+  return reinterpret_cast<const record*>(file.data() + sizeof(header));
+}
+
+const mapped_documentation_set::slot* mapped_documentation_set::names() const {
+  return reinterpret_cast<const slot*>(records() + head().records);
+}
+
+const mapped_documentation_set::slot* mapped_documentation_set::suffixes() const {
+  return names() + head().names;
+}
+
+std::string_view mapped_documentation_set::str(const string& value) const {
+  const char* table = reinterpret_cast<const char*>(suffixes() + head().suffixes);
+  return std::string_view(table + value.offset, value.length);
+}
+
+entry mapped_documentation_set::materialize(const record& record) const {
+  return entry(std::string(str(record.name)), std::string(str(record.domain)), std::string(str(record.type)), record.priority, std::string(str(record.uri)), std::string(str(record.display_name)));
+}
+
+const mapped_documentation_set::slot* mapped_documentation_set::probe(const slot* slots, std::uint32_t count, std::string_view name) const {
+  return detail::probe(slots, count, name, [&](const slot& slot) { return str(records()[slot.record - 1].name); });
+}
+
+}
@@ -2,7 +2,12 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/erase.hpp>
@@ -19,8 +24,12 @@
 
 #include "../../standardese/inventory/symbols.hpp"
 #include "../../standardese/inventory/cppast_inventory.hpp"
+#include "../../standardese/inventory/doxygen/tagfile_index.hpp"
+#include "../../standardese/inventory/doxygen/mapped_tagfile_index.hpp"
 #include "../../standardese/inventory/sphinx/documentation_set.hpp"
+#include "../../standardese/inventory/sphinx/mapped_documentation_set.hpp"
 #include "../../standardese/logger.hpp"
+#include "../../standardese/stats.hpp"
 
 // TODO: We do not handle friend declarations correctly here. A class can
 // declare a friend function that then lives in the surrounding namespace of
@@ -30,19 +39,52 @@
 
 namespace standardese::inventory {
 
+namespace {
+
+/// Return the position and the length of the first separator `.` or `::` in
+/// `name`; or `npos` if there is no such separator.
+std::pair<std::size_t, std::size_t> separator(const std::string& name) {
+  for (std::size_t i = 0; i < name.size(); i++) {
+    if (name[i] == '.')
+      return {i, 1};
+    if (name[i] == ':' && i + 1 < name.size() && name[i + 1] == ':')
+      return {i, 2};
+  }
+  return {std::string::npos, 0};
+}
+
+}
+
 class symbols::impl {
  public:
   virtual ~impl() {}
 
+  /// A distinct lookup in a batch of lookups.
+  struct query {
+    std::string name;
+
+    /// The scope of the lookup, null for a global lookup.
+    const cppast::cpp_entity* scope;
+
+    type_safe::optional<model::link_target> target;
+  };
+
   virtual type_safe::optional<model::link_target> find(const std::string& name) const = 0;
   virtual type_safe::optional<model::link_target> find(const std::string& name, const cppast::cpp_entity& entity) const;
 
+  /// Resolve the `queries` which are sorted by scope and name.
+  virtual void find(std::vector<query>& queries) const;
+
+  virtual std::size_t memory() const;
+
   template <typename T>
   class generic_symbols;
 
   class cppast_symbols;
   class doxygen_symbols;
+  class mapped_doxygen_symbols;
   class sphinx_symbols;
+  class mapped_sphinx_symbols;
 };
 
 template <typename T>
@@ -61,6 +103,8 @@ class symbols::impl::cppast_symbols : public symbols::impl::generic_symbols<cppa
 
   type_safe::optional<model::link_target> find(const std::string& name) const override;
   type_safe::optional<model::link_target> find(const std::string& name, const cppast::cpp_entity& entity) const override;
+  void find(std::vector<query>& queries) const override;
+  std::size_t memory() const override;
 
   type_safe::optional_ref<const cppast::cpp_entity> child(const cppast::cpp_entity&, const std::string& name) const override;
   type_safe::optional_ref<const cppast::cpp_entity> parameter(const cppast::cpp_entity&, const std::string& name) const override;
@@ -68,7 +112,33 @@ class symbols::impl::cppast_symbols : public symbols::impl::generic_symbols<cppa
   type_safe::optional_ref<const cppast::cpp_entity> base_class(const cppast::cpp_entity&, const std::string& name) const override;
 
  private:
-  bool matches(const cppast::cpp_entity& entity, const std::string& search) const;
+  /// Return the entity `name` in the global scope.
+  type_safe::optional_ref<const cppast::cpp_entity> global(const std::string& name) const;
+
+  /// The leading qualifier of a name, e.g., `X` in `X::f`, resolved in the
+  /// scopes that have been searched for it so far.
+  struct qualifier {
+    std::string name;
+    std::unordered_map<const cppast::cpp_entity*, type_safe::optional_ref<const cppast::cpp_entity>> scopes;
+  };
+
+  /// Return the entity `name` as seen from `scope`, i.e., in `scope` or
+  /// any of its parents. The result is cached, see [cppast_inventory]().
+  /// If `leading` is given, it must be the leading qualifier of `name` and
+  /// `name` is resolved through it.
+  type_safe::optional_ref<const cppast::cpp_entity> relative(const std::string& name, const cppast::cpp_entity& scope, qualifier* leading = nullptr) const;
+
+  /// Return the entity `name` in `scope` like `descendant` does but resolve
+  /// the leading qualifier of `name` through `leading`.
+  type_safe::optional_ref<const cppast::cpp_entity> qualified(const std::string& name, const cppast::cpp_entity& scope, qualifier& leading) const;
+
+  /// Return the members of `scope` indexed by the names they can be found
+  /// by.
+  const std::unordered_map<std::string, const cppast::cpp_entity*>& members(const cppast::cpp_entity& scope) const;
+
+  /// Return the names that `entity` can be found by, i.e., its name with or
+  /// without template parameters and function signature.
+  std::vector<std::string> names(const cppast::cpp_entity& entity) const;
   std::string template_parameters(const cppast::cpp_entity& entity) const;
   std::string parameter_names(const cppast::cpp_entity& entity) const;
   std::string signature(const cppast::cpp_entity& entity) const;
@@ -81,9 +151,65 @@ class symbols::impl::sphinx_symbols : public symbols::impl {
   sphinx_symbols(const sphinx::documentation_set&);
 
   type_safe::optional<model::link_target> find(const std::string& name) const override;
+  std::size_t memory() const override;
 
  private:
+  /// Return whether the entry `candidate` should be preferred over the entry
+  /// `current`, i.e., whether it has a better priority.
+  bool preferred(std::size_t candidate, std::size_t current) const;
+
   const sphinx::documentation_set& inventory;
+
+  /// The entry with the best priority for each name.
+  std::unordered_map<std::string_view, std::size_t> names;
+
+  struct suffix {
+    std::size_t entry;
+
+    /// Whether several entries with the same best priority end in this
+    /// suffix. Such suffixes do not resolve at all.
+    bool ambiguous;
+  };
+
+  /// The entries for each trailing part of their qualified names, e.g.,
+  /// `vector::push_back` and `push_back` for `std::vector::push_back`.
+  std::unordered_map<std::string_view, suffix> suffixes;
+};
+
+/// Symbols of a [doxygen::tagfile_index]() which already contains the
+/// location of every entity by its fully qualified name.
+class symbols::impl::doxygen_symbols : public symbols::impl {
+ public:
+  doxygen_symbols(const doxygen::tagfile_index&);
+
+  type_safe::optional<model::link_target> find(const std::string& name) const override;
+  std::size_t memory() const override;
+
+ private:
+  const doxygen::tagfile_index& inventory;
+};
+
+/// Symbols of a [doxygen::mapped_tagfile_index]().
+class symbols::impl::mapped_doxygen_symbols : public symbols::impl {
+ public:
+  mapped_doxygen_symbols(const doxygen::mapped_tagfile_index&);
+
+  type_safe::optional<model::link_target> find(const std::string& name) const override;
+
+ private:
+  const doxygen::mapped_tagfile_index& inventory;
+};
+
+/// Symbols of a [sphinx::mapped_documentation_set]() which already contains
+/// all the indexes needed for lookups.
+class symbols::impl::mapped_sphinx_symbols : public symbols::impl {
+ public:
+  mapped_sphinx_symbols(const sphinx::mapped_documentation_set&);
+
+  type_safe::optional<model::link_target> find(const std::string& name) const override;
+
+ private:
+  const sphinx::mapped_documentation_set& inventory;
 };
 
 symbols::symbols(const inventory& inventory) {
@@ -91,6 +217,12 @@ symbols::symbols(const inventory& inventory) {
     self = std::make_unique<impl::cppast_symbols>(static_cast<const cppast_inventory&>(inventory));
   } else if (dynamic_cast<const sphinx::documentation_set*>(&inventory) != nullptr) {
     self = std::make_unique<impl::sphinx_symbols>(static_cast<const sphinx::documentation_set&>(inventory));
+  } else if (dynamic_cast<const doxygen::tagfile_index*>(&inventory) != nullptr) {
+    self = std::make_unique<impl::doxygen_symbols>(static_cast<const doxygen::tagfile_index&>(inventory));
+  } else if (dynamic_cast<const doxygen::mapped_tagfile_index*>(&inventory) != nullptr) {
+    self = std::make_unique<impl::mapped_doxygen_symbols>(static_cast<const doxygen::mapped_tagfile_index&>(inventory));
+  } else if (dynamic_cast<const sphinx::mapped_documentation_set*>(&inventory) != nullptr) {
+    self = std::make_unique<impl::mapped_sphinx_symbols>(static_cast<const sphinx::mapped_documentation_set&>(inventory));
   } else {
     throw std::logic_error("not implemented: symbols for this type of inventory");
   }
@@ -113,6 +245,8 @@ type_safe::optional<model::link_target> symbols::find(const std::string& name_)
   return self->find(name);
 }
 
+symbols::lookup::lookup(std::string name, type_safe::optional_ref<const cppast::cpp_entity> scope) : name(std::move(name)), scope(scope) {}
+
 type_safe::optional<model::link_target> symbols::find(const std::string& name, const cppast::cpp_entity& entity) const {
   if (entity.kind() == cppast::cpp_file::kind())
     return this->find(name);
@@ -127,34 +261,204 @@ type_safe::optional<model::link_target> symbols::find(const std::string& name, c
   return self->find(name, entity);
 }
 
+void symbols::find(std::vector<lookup>& lookups) const {
+  // Normalize the lookups like the other overloads of find() do.
+  std::vector<std::pair<impl::query, lookup*>> normalized;
+  normalized.reserve(lookups.size());
+
+  for (auto& lookup : lookups) {
+    lookup.target = type_safe::nullopt;
+
+    std::string name = lookup.name;
+    const cppast::cpp_entity* scope = lookup.scope ? &lookup.scope.value() : nullptr;
+
+    if (scope != nullptr && scope->kind() == cppast::cpp_file::kind())
+      scope = nullptr;
+
+    if (boost::starts_with(name, "::")) {
+      name = name.substr(2);
+      scope = nullptr;
+    }
+
+    if (name.empty())
+      continue;
+
+    normalized.push_back({impl::query{std::move(name), scope, type_safe::nullopt}, &lookup});
+  }
+
+  std::sort(normalized.begin(), normalized.end(), [](const auto& lhs, const auto& rhs) {
+    return std::tie(lhs.first.scope, lhs.first.name) < std::tie(rhs.first.scope, rhs.first.name);
+  });
+
+  // Perform each distinct lookup only once.
+  std::vector<impl::query> queries;
+  std::vector<std::size_t> distinct;
+  distinct.reserve(normalized.size());
+
+  for (auto& [query, lookup] : normalized) {
+    if (queries.empty() || queries.back().scope != query.scope || queries.back().name != query.name)
+      queries.push_back(std::move(query));
+    distinct.push_back(queries.size() - 1);
+  }
+
+  self->find(queries);
+
+  for (std::size_t i = 0; i < normalized.size(); i++)
+    normalized[i].second->target = queries[distinct[i]].target;
+}
+
+std::size_t symbols::memory() const {
+  return self->memory();
+}
+
 type_safe::optional<model::link_target> symbols::impl::find(const std::string& name, const cppast::cpp_entity&) const {
   return find(name);
 }
 
+void symbols::impl::find(std::vector<query>& queries) const {
+  for (auto& query : queries)
+    query.target = query.scope == nullptr ? find(query.name) : find(query.name, *query.scope);
+}
+
+std::size_t symbols::impl::memory() const {
+  return 0;
+}
+
 symbols::impl::cppast_symbols::cppast_symbols(const cppast_inventory& inventory) : inventory(inventory) {}
 
 type_safe::optional<model::link_target> symbols::impl::cppast_symbols::find(const std::string& name) const {
+  auto search = global(name);
+  if (search)
+    return model::link_target(search.value());
+
+  return type_safe::nullopt;
+}
+
+type_safe::optional<model::link_target> symbols::impl::cppast_symbols::find(const std::string& name, const cppast::cpp_entity& entity) const {
+  if (inventory.roots.find(&cppast_inventory::root(entity)) == inventory.roots.end())
+    throw std::invalid_argument("Cannot look up symbol relative to something not defined in any of the loaded files.");
+
+  auto search = relative(name, entity);
+  if (search)
+    return model::link_target(search.value());
+
+  return type_safe::nullopt;
+}
+
+void symbols::impl::cppast_symbols::find(std::vector<query>& queries) const {
+  for (auto begin = queries.begin(); begin != queries.end();) {
+    const auto* scope = begin->scope;
+    const auto end = std::find_if(begin, queries.end(), [&](const auto& query) { return query.scope != scope; });
+
+    if (scope == nullptr) {
+      for (auto query = begin; query != end; query++)
+        query->target = find(query->name);
+    } else {
+      if (inventory.roots.find(&cppast_inventory::root(*scope)) == inventory.roots.end())
+        throw std::invalid_argument("Cannot look up symbol relative to something not defined in any of the loaded files.");
+
+      // Since the queries are sorted, the names that share a leading
+      // qualifier are adjacent.
+      qualifier leading;
+
+      for (auto query = begin; query != end; query++) {
+        type_safe::optional_ref<const cppast::cpp_entity> search;
+
+        const auto position = separator(query->name).first;
+        if (position == std::string::npos) {
+          search = relative(query->name, *scope);
+        } else {
+          if (query->name.compare(0, position, leading.name) != 0 || leading.name.size() != position) {
+            leading.name = query->name.substr(0, position);
+            leading.scopes.clear();
+          }
+          search = relative(query->name, *scope, &leading);
+        }
+
+        if (search)
+          query->target = model::link_target(search.value());
+      }
+    }
+
+    begin = end;
+  }
+}
+
+type_safe::optional_ref<const cppast::cpp_entity> symbols::impl::cppast_symbols::global(const std::string& name) const {
   for (auto* root : inventory.roots) {
       auto search = descendant(*root, name);
       if (search)
-          return search.value();
+          return search;
   }
       
   return type_safe::nullopt;
 }
 
-type_safe::optional<model::link_target> symbols::impl::cppast_symbols::find(const std::string& name, const cppast::cpp_entity& entity) const {
-  if (inventory.roots.find(&cppast_inventory::root(entity)) == inventory.roots.end())
-    throw std::invalid_argument("Cannot look up symbol relative to something not defined in any of the loaded files.");
+type_safe::optional_ref<const cppast::cpp_entity> symbols::impl::cppast_symbols::relative(const std::string& name, const cppast::cpp_entity& scope, qualifier* leading) const {
+  auto& index = *inventory.index;
+  auto& shard = index.lookups[(std::hash<const cppast::cpp_entity*>()(&scope) ^ std::hash<std::string>()(name)) % index.lookups.size()];
+
+  {
+    std::shared_lock lock{shard.mutex};
+    const auto lookups = shard.lookups.find(&scope);
+    if (lookups != shard.lookups.end()) {
+      const auto cached = lookups->second.find(name);
+      if (cached != lookups->second.end()) {
+        index.hits++;
+        return type_safe::opt_ref(cached->second);
+      }
+    }
+  }
 
-  auto search = descendant(entity, name);
-  if (search.has_value())
-      return search.value();
+  index.misses++;
 
-  if (!entity.parent().has_value())
-    return this->find(name);
+  auto search = leading ? qualified(name, scope, *leading) : descendant(scope, name);
+  if (!search)
+    search = scope.parent() ? relative(name, scope.parent().value(), leading) : global(name);
 
-  return this->find(name, entity.parent().value());
+  {
+    std::unique_lock lock{shard.mutex};
+    shard.lookups[&scope].emplace(name, search ? &search.value() : nullptr);
+  }
+
+  return search;
+}
+
+type_safe::optional_ref<const cppast::cpp_entity> symbols::impl::cppast_symbols::qualified(const std::string& name, const cppast::cpp_entity& scope, qualifier& leading) const {
+  auto resolved = leading.scopes.find(&scope);
+  if (resolved == leading.scopes.end())
+    resolved = leading.scopes.emplace(&scope, descendant(scope, leading.name)).first;
+
+  if (!resolved->second)
+    return type_safe::nullopt;
+
+  const auto [position, length] = separator(name);
+  return descendant(resolved->second.value(), name.substr(position + length));
+}
+
+std::size_t symbols::impl::cppast_symbols::memory() const {
+  auto& index = *inventory.index;
+
+  std::shared_lock lock{index.mutex};
+
+  std::size_t memory = sizeof(index) + index.members.bucket_count() * sizeof(void*);
+  for (const auto& [scope, members] : index.members) {
+    memory += sizeof(scope) + sizeof(members) + members.bucket_count() * sizeof(void*);
+    for (const auto& [name, member] : members)
+      memory += sizeof(name) + name.capacity() + sizeof(member);
+  }
+
+  for (auto& shard : index.lookups) {
+    std::shared_lock lock{shard.mutex};
+    memory += shard.lookups.bucket_count() * sizeof(void*);
+    for (const auto& [scope, lookups] : shard.lookups) {
+      memory += sizeof(scope) + sizeof(lookups) + lookups.bucket_count() * sizeof(void*);
+      for (const auto& [name, result] : lookups)
+        memory += sizeof(name) + name.capacity() + sizeof(result);
+    }
+  }
+
+  return memory;
 }
 
 template <typename T>
@@ -165,17 +469,16 @@ type_safe::optional_ref<const T> symbols::impl::generic_symbols<T>::descendant(c
   // We do not distinguish these two operators at all `.` and `::`. Originally,
   // we used `.` for function arguments and `::` in the usual C++ sense but
   // there seems to be not much of a point in enforcing such rules.
-  static auto separator = std::regex(R"(\.|::)");
 
   // The recursive case: if the name contains `::` or `.`, split the name at
-  // this separator and search recursively.
-  std::smatch match;
-  if (std::regex_search(name, match, separator)) {
-      auto child = descendant(root, match.prefix());
-      if (child)
-          return descendant(child.value(), match.suffix());
+  // the first such separator and search recursively.
+  const auto [position, length] = separator(name);
+  if (position != std::string::npos) {
+    auto child = descendant(root, name.substr(0, position));
+    if (child)
+        return descendant(child.value(), name.substr(position + length));
 
-      return type_safe::nullopt;
+    return type_safe::nullopt;
   }
 
   // The base case, lookup name itself in the root entity.
@@ -228,39 +531,12 @@ type_safe::optional_ref<const cppast::cpp_entity> symbols::impl::cppast_symbols:
   if (cppast::is_template(root->kind()))
       root = &(*static_cast<const cppast::cpp_template&>(*root).begin());
 
-  type_safe::optional_ref<const cppast::cpp_entity> child;  
-  cppast::visit(*root, [&](const auto& entity, auto info) {
-    if (&entity == root)
-      // Enter the root container and abort when leaving it.
-      return true;
-
-    if (entity.kind() == cppast::cpp_language_linkage::kind())
-      // A linkage does not create a naming scope and we never want to link to it.
-      return true;
-
-    if (matches(entity, name))
-        child = type_safe::ref(entity);
-
-    switch(info.event) {
-      case cppast::visitor_info::event_type::container_entity_enter:
-          // Do not consider the children of this container. Here we are only
-          // looking for a name without `::` or `.`
-          return false;
-      case cppast::visitor_info::event_type::container_entity_exit:
-          // We "exit" the container that we did not actually enter in the
-          // preceding case. Continue the search.
-          [[fallthrough]];
-      case cppast::visitor_info::event_type::leaf_entity:
-          if (child)
-              // Abort the search.
-              return false;
-          // Continue the search.
-          return true;
-      default:
-          throw std::logic_error("visitor in unexpected state");
-    }
+  type_safe::optional_ref<const cppast::cpp_entity> child;
 
-  });
+  const auto& members = this->members(*root);
+  const auto member = members.find(name);
+  if (member != members.end())
+    child = type_safe::ref(*member->second);
 
   // It is customary to write `typedef struct S {} S;` or `typedef struct {}
   // S;` especially in C. Technically, an "S" would refer to the typedef, but
@@ -306,10 +582,56 @@ type_safe::optional_ref<const cppast::cpp_entity> symbols::impl::cppast_symbols:
   return type_safe::nullopt;
 }
 
-bool symbols::impl::cppast_symbols::matches(const cppast::cpp_entity& entity, const std::string& search) const {
+const std::unordered_map<std::string, const cppast::cpp_entity*>& symbols::impl::cppast_symbols::members(const cppast::cpp_entity& scope) const {
+  auto& index = *inventory.index;
+
+  {
+    std::shared_lock lock{index.mutex};
+    auto indexed = index.members.find(&scope);
+    if (indexed != index.members.end())
+      return indexed->second;
+  }
+
+  std::unordered_map<std::string, const cppast::cpp_entity*> members;
+
+  cppast::visit(scope, [&](const auto& entity, auto info) {
+    if (&entity == &scope)
+      // Enter the scope and stop when leaving it.
+      return true;
+
+    if (entity.kind() == cppast::cpp_language_linkage::kind())
+      // A linkage does not create a naming scope and we never want to link to it.
+      return true;
+
+    switch(info.event) {
+      case cppast::visitor_info::event_type::container_entity_enter:
+          // Do not consider the children of this container. They are in a
+          // different scope.
+          [[fallthrough]];
+      case cppast::visitor_info::event_type::leaf_entity:
+          // If several members have the same name, the first one wins.
+          for (auto& name : names(entity))
+            members.emplace(std::move(name), &entity);
+          return info.event == cppast::visitor_info::event_type::leaf_entity;
+      case cppast::visitor_info::event_type::container_entity_exit:
+          // We "exit" the container that we did not actually enter in the
+          // preceding case. Continue with the next member.
+          return true;
+      default:
+          throw std::logic_error("visitor in unexpected state");
+    }
+  });
+
+  // Another thread might have indexed this scope in the meantime. Then we
+  // use its index which is identical to ours.
+  std::unique_lock lock{index.mutex};
+  return index.members.emplace(&scope, std::move(members)).first->second;
+}
+
+std::vector<std::string> symbols::impl::cppast_symbols::names(const cppast::cpp_entity& entity) const {
   if (entity.kind() == cppast::cpp_file::kind())
       // We do not want to match with C++ header files here. They are handled separately.
-      return false;
+      return {};
 
   /* TODO
   if (entity.kind() == cppast::cpp_friend::kind())
@@ -321,14 +643,14 @@ bool symbols::impl::cppast_symbols::matches(const cppast::cpp_entity& entity, co
   const auto sig = boost::erase_all_copy(signature(entity), " ");
   const auto names = parameter_names(entity);
 
-  if (search == name) return true;
-  if (search == name + temp) return true;
-  if (search == name + sig) return true;
-  if (search == name + names) return true;
-  if (search == name + temp + sig) return true;
-  if (search == name + temp + names) return true;
-
-  return false;
+  return {
+    name,
+    name + temp,
+    name + sig,
+    name + names,
+    name + temp + sig,
+    name + temp + names,
+  };
 }
 
 std::string symbols::impl::cppast_symbols::template_parameters(const cppast::cpp_entity& entity) const {
@@ -371,24 +693,96 @@ std::string symbols::impl::cppast_symbols::signature(const cppast::cpp_entity& e
   return static_cast<const cppast::cpp_function_base&>(entity).signature();
 }
 
-symbols::impl::sphinx_symbols::sphinx_symbols(const sphinx::documentation_set& inventory) : inventory(inventory) {}
+symbols::impl::sphinx_symbols::sphinx_symbols(const sphinx::documentation_set& inventory) : inventory(inventory) {
+  stats::timer timer{"link inventory: index external inventories"};
 
-type_safe::optional<model::link_target> symbols::impl::sphinx_symbols::find(const std::string& name) const {
-  type_safe::optional<sphinx::entry> match;
-
-  // TODO: We should be much more fuzzy here.
-  // TODO: We could be better than O(n) here.
-  for (const auto& entry : inventory.entries) {
-    if (entry.name == name) {
-      if (!match.has_value() || match.value().priority > entry.priority)
-        match = entry;
-    }
+  names.reserve(inventory.entries.size());
+
+  for (std::size_t entry = 0; entry < inventory.entries.size(); entry++) {
+    const std::string_view name = inventory.entries[entry].name;
+
+    const auto [best, inserted] = names.emplace(name, entry);
+    if (!inserted && preferred(entry, best->second))
+      best->second = entry;
+
+    // Index all the trailing parts of the name that start after a `::` or
+    // `.` separator.
+    sphinx::for_each_suffix(name, [&](std::string_view trailing) {
+      const auto [match, inserted] = suffixes.emplace(trailing, suffix{entry, false});
+      if (inserted || match->second.entry == entry)
+        return;
+
+      if (preferred(entry, match->second.entry))
+        match->second = suffix{entry, false};
+      else if (!preferred(match->second.entry, entry))
+        match->second.ambiguous = true;
+    });
   }
+}
+
+bool symbols::impl::sphinx_symbols::preferred(std::size_t candidate, std::size_t current) const {
+  return inventory.entries[candidate].priority < inventory.entries[current].priority;
+}
+
+type_safe::optional<model::link_target> symbols::impl::sphinx_symbols::find(const std::string& name) const {
+  const auto match = names.find(name);
+  if (match != names.end())
+    return model::link_target::sphinx_target(inventory, inventory.entries[match->second]);
+
+  // There is no entry with exactly this name. Try to find an entry that is
+  // qualified further, e.g., `vector::push_back` for `std::vector::push_back`.
+  const auto suffix = suffixes.find(name);
+  if (suffix != suffixes.end() && !suffix->second.ambiguous)
+    return model::link_target::sphinx_target(inventory, inventory.entries[suffix->second.entry]);
+
+  return type_safe::nullopt;
+}
+
+std::size_t symbols::impl::sphinx_symbols::memory() const {
+  std::size_t memory = inventory.entries.capacity() * sizeof(sphinx::entry);
+  memory += names.bucket_count() * sizeof(void*) + names.size() * (sizeof(std::string_view) + sizeof(std::size_t) + sizeof(void*));
+  memory += suffixes.bucket_count() * sizeof(void*) + suffixes.size() * (sizeof(std::string_view) + sizeof(suffix) + sizeof(void*));
+  for (const auto& entry : inventory.entries)
+    memory += entry.name.capacity() + entry.domain.capacity() + entry.type.capacity() + entry.uri.capacity() + entry.display_name.capacity();
+  return memory;
+}
+
+
+symbols::impl::doxygen_symbols::doxygen_symbols(const doxygen::tagfile_index& inventory) : inventory(inventory) {}
+
+type_safe::optional<model::link_target> symbols::impl::doxygen_symbols::find(const std::string& name) const {
+  const auto match = inventory.find(name);
+  if (!match)
+    return type_safe::nullopt;
+
+  return model::link_target::doxygen_target(inventory, name, std::string(match.value().filename), match.value().anchor);
+}
+
+std::size_t symbols::impl::doxygen_symbols::memory() const {
+  return inventory.memory();
+}
+
+symbols::impl::mapped_doxygen_symbols::mapped_doxygen_symbols(const doxygen::mapped_tagfile_index& inventory) : inventory(inventory) {}
+
+type_safe::optional<model::link_target> symbols::impl::mapped_doxygen_symbols::find(const std::string& name) const {
+  const auto match = inventory.find(name);
+  if (!match)
+    return type_safe::nullopt;
+
+  return model::link_target::doxygen_target(inventory, name, std::string(match.value().filename), match.value().anchor);
+}
+
+symbols::impl::mapped_sphinx_symbols::mapped_sphinx_symbols(const sphinx::mapped_documentation_set& inventory) : inventory(inventory) {}
+
+type_safe::optional<model::link_target> symbols::impl::mapped_sphinx_symbols::find(const std::string& name) const {
+  auto entry = inventory.find(name);
+  if (!entry)
+    entry = inventory.find_suffix(name);
 
-  if (!match.has_value())
+  if (!entry)
     return type_safe::nullopt;
 
-  return model::link_target::sphinx_target(inventory, match.value());
+  return model::link_target::sphinx_target(inventory, std::move(entry.value()));
 }
 
 }
@@ -68,6 +68,11 @@ void info(const std::string& msg) {
   get().info(msg);
 }
 
+void info(const std::function<std::string()>& msg) {
+  if (get().should_log(spdlog::level::info))
+    info(msg());
+}
+
 void debug(const std::string& msg) { 
   get().debug(msg);
 }
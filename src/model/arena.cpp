@@ -0,0 +1,102 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "../../standardese/model/arena.hpp"
+
+namespace standardese::model {
+
+namespace {
+
+/// The arena that the calling thread allocates new entities in.
+thread_local arena* current = nullptr;
+
+std::atomic<std::uint64_t> identifiers = 0;
+
+/// The slabs the calling thread allocated from last.
+thread_local struct {
+  std::uint64_t arena = 0;
+  std::pmr::monotonic_buffer_resource* slabs = nullptr;
+} cached;
+
+}
+
+arena::arena() : id(++identifiers) {}
+
+arena::~arena() {}
+
+arena::scope::scope(arena& arena) : previous(std::exchange(current, &arena)) {}
+
+arena::scope::~scope() {
+  current = previous;
+}
+
+arena* arena::active() noexcept {
+  return current;
+}
+
+std::pmr::memory_resource* arena::resource() noexcept {
+  if (current)
+    return current;
+  return std::pmr::get_default_resource();
+}
+
+std::size_t arena::memory() const {
+  return upstream.reserved;
+}
+
+void* arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  return slabs().allocate(bytes, alignment);
+}
+
+void arena::do_deallocate(void*, std::size_t, std::size_t) {
+  // Memory is only released when the entire arena is destroyed.
+}
+
+bool arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+std::pmr::monotonic_buffer_resource& arena::slabs() {
+  if (cached.arena != id) {
+    // A thread often alternates between the arenas of different documents
+    // so we must not start new slabs when it comes back to this arena.
+    std::unique_lock lock{mutex};
+    auto& slabs = threads[std::this_thread::get_id()];
+    if (!slabs)
+      slabs = std::make_unique<std::pmr::monotonic_buffer_resource>(std::size_t{1} << 16, &upstream);
+    cached.arena = id;
+    cached.slabs = slabs.get();
+  }
+  return *cached.slabs;
+}
+
+void* arena::upstream::do_allocate(std::size_t bytes, std::size_t alignment) {
+  reserved.fetch_add(bytes, std::memory_order_relaxed);
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void arena::upstream::do_deallocate(void* slab, std::size_t bytes, std::size_t alignment) {
+  reserved.fetch_sub(bytes, std::memory_order_relaxed);
+  std::pmr::new_delete_resource()->deallocate(slab, bytes, alignment);
+}
+
+bool arena::upstream::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+arena& arenas::create() {
+  std::unique_lock lock{mutex};
+  return values.emplace_back();
+}
+
+std::size_t arenas::memory() const {
+  std::unique_lock lock{mutex};
+
+  std::size_t memory = 0;
+  for (const auto& arena : values)
+    memory += arena.memory();
+  return memory;
+}
+
+}
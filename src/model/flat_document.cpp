@@ -0,0 +1,146 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <iterator>
+
+#include "../../standardese/model/flat_document.hpp"
+#include "../../standardese/model/visitor/generic_visitor.hpp"
+
+namespace standardese::model
+{
+
+namespace {
+
+template <typename T>
+constexpr bool is_container_v = std::is_base_of_v<mixin::container<>, T> || std::is_base_of_v<mixin::container<markup::list_item>, T>;
+
+}
+
+/// Appends the nodes of a tree to a [flat_document]() in pre-order.
+/// The tree is traversed as const so that shared nodes are not copied.
+template <bool is_const>
+struct flat_document<is_const>::builder : visitor::generic_visitor<builder, visitor::visitor<true>> {
+  builder(flat_document& flat, bool text) : flat(flat), text(text) {}
+
+  template <typename T>
+  void operator()(const T& node) {
+    const index self = flat.size();
+
+    flat.kinds.push_back(kind_of(&node));
+    flat.parents.push_back(parent);
+    flat.first_children.push_back(none);
+    flat.next_siblings.push_back(none);
+    flat.ends.push_back(none);
+    flat.nodes.push_back(const_cast<T*>(&node));
+    if constexpr (!is_const)
+      flat.detached.push_back(false);
+    if (text)
+      flat.offsets.push_back(static_cast<std::uint32_t>(flat.strings.size()));
+
+    if (previous != none)
+      flat.next_siblings[previous] = self;
+    else if (parent != none)
+      flat.first_children[parent] = self;
+
+    using S = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<S, markup::text>)
+      if (text)
+        flat.strings += node.value;
+
+    if constexpr (is_container_v<S>) {
+      parent = self;
+      previous = none;
+
+      for (auto& child : node) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(child)>, entity>)
+          child.accept(*this);
+        else
+          (*this)(child);
+      }
+
+      parent = flat.parents[self];
+    }
+
+    previous = self;
+    flat.ends[self] = flat.size();
+  }
+
+  flat_document& flat;
+
+  /// Whether to collect the values of the text nodes.
+  const bool text;
+
+  /// The node whose children are currently added.
+  index parent = none;
+
+  /// The last child that has been added to `parent`.
+  index previous = none;
+};
+
+template <bool is_const>
+flat_document<is_const>::flat_document(conditional_const<entity>& root, bool text) : root(&root) {
+  builder build{*this, text};
+  static_cast<const entity&>(root).accept(build);
+  if (text)
+    offsets.push_back(static_cast<std::uint32_t>(strings.size()));
+}
+
+template <bool is_const>
+void flat_document<is_const>::detach(index node) const {
+  if constexpr (!is_const) {
+    if (detached[node])
+      return;
+
+    const index parent = parents[node];
+
+    // Replace the pointer to `node` with a pointer to its copy.
+    const auto rebind = [&](entity& handle) {
+      dispatch(node, [&](auto& value) {
+        nodes[node] = &handle.template as<std::decay_t<decltype(value)>>();
+      });
+    };
+
+    if (parent == none) {
+      rebind(*root);
+    } else {
+      detach(parent);
+
+      std::size_t position = 0;
+      for (index sibling = first_children[parent]; sibling != node; sibling = next_siblings[sibling])
+        position++;
+
+      dispatch(parent, [&](auto& container) {
+        if constexpr (is_container_v<std::decay_t<decltype(container)>>) {
+          auto& child = *std::next(container.begin(), position);
+          if constexpr (std::is_same_v<std::decay_t<decltype(child)>, entity>)
+            rebind(child);
+          else
+            nodes[node] = &child;
+        }
+      });
+    }
+
+    detached[node] = true;
+
+    // Children that are not entities of their own, such as the items of a
+    // list, have been copied with this node.
+    dispatch(node, [&](auto& container) {
+      using S = std::decay_t<decltype(container)>;
+      if constexpr (std::is_base_of_v<mixin::container<markup::list_item>, S>) {
+        index child = first_children[node];
+        for (auto& item : container) {
+          nodes[child] = &item;
+          detached[child] = true;
+          child = next_siblings[child];
+        }
+      }
+    });
+  }
+}
+
+template class flat_document<true>;
+template class flat_document<false>;
+
+}
@@ -0,0 +1,78 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "../../standardese/model/interned_string.hpp"
+
+namespace standardese::model {
+
+namespace {
+
+/// The strings interned so far.
+/// The table is split into shards that are locked separately so that
+/// threads interning strings concurrently rarely wait for each other.
+struct table {
+  struct shard {
+    std::mutex mutex;
+
+    /// The interned strings. A deque never moves its elements so handles
+    /// and the keys of `index` remain valid.
+    std::deque<std::string> strings;
+
+    std::unordered_map<std::string_view, const std::string*> index;
+  };
+
+  std::array<shard, 64> shards;
+
+  std::atomic<std::size_t> memory = 0;
+
+  const std::string empty;
+};
+
+table& strings() {
+  // The table is never destroyed so that handles remain valid while static
+  // objects are being destroyed.
+  static table* strings = new table();
+  return *strings;
+}
+
+}
+
+interned_string::interned_string() noexcept : value(&strings().empty) {}
+
+interned_string::interned_string(std::string_view value) {
+  auto& table = strings();
+
+  if (value.empty()) {
+    this->value = &table.empty;
+    return;
+  }
+
+  auto& shard = table.shards[std::hash<std::string_view>()(value) % table.shards.size()];
+
+  std::lock_guard lock{shard.mutex};
+
+  const auto search = shard.index.find(value);
+  if (search != shard.index.end()) {
+    this->value = search->second;
+    return;
+  }
+
+  const std::string& interned = shard.strings.emplace_back(value);
+  shard.index.emplace(interned, &interned);
+  table.memory += sizeof(std::string) + interned.capacity() + 1 + sizeof(decltype(shard.index)::value_type) + 2 * sizeof(void*);
+
+  this->value = &interned;
+}
+
+std::size_t interned_string::memory() {
+  return strings().memory;
+}
+
+}
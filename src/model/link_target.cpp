@@ -3,12 +3,15 @@
 // found in the top-level directory of this distribution.
 
 #include "../../standardese/model/link_target.hpp"
+#include "../../standardese/inventory/sphinx/mapped_documentation_set.hpp"
+#include "../../standardese/inventory/doxygen/tagfile_index.hpp"
+#include "../../standardese/inventory/doxygen/mapped_tagfile_index.hpp"
 #include <variant>
 
 namespace standardese::model
 {
 
-link_target::link_target(std::string target) : target(standardese_target(std::move(target))) {}
+link_target::link_target(interned_string target) : target(standardese_target(target)) {}
 
 link_target::link_target(module_target target) : target(std::move(target)) {}
 
@@ -16,23 +19,31 @@ link_target::link_target(const cppast::cpp_entity& entity) : target(cppast_targe
 
 link_target::link_target(sphinx_target target) : target(std::move(target)) {}
 
+link_target::link_target(doxygen_target target) : target(std::move(target)) {}
+
 link_target::link_target(uri_target target) : target(std::move(target)) {}
 
-link_target::standardese_target::standardese_target(std::string target) : target(std::move(target)) {}
+link_target::standardese_target::standardese_target(interned_string target) : target(target) {}
 
 link_target::cppast_target::cppast_target(const cppast::cpp_entity& entity) : target(entity) {}
 
 link_target::sphinx_target::sphinx_target(const inventory::sphinx::documentation_set& inventory, inventory::sphinx::entry entry) : project(inventory.project), version(inventory.version), entry(std::move(entry)) {}
 
+link_target::sphinx_target::sphinx_target(const inventory::sphinx::mapped_documentation_set& inventory, inventory::sphinx::entry entry) : project(inventory.project()), version(inventory.version()), entry(std::move(entry)) {}
+
+link_target::doxygen_target::doxygen_target(const inventory::doxygen::tagfile_index& inventory, std::string name, std::string filename, std::string anchor) : inventory(inventory), name(std::move(name)), filename(std::move(filename)), anchor(std::move(anchor)) {}
+
+link_target::doxygen_target::doxygen_target(const inventory::doxygen::mapped_tagfile_index& inventory, std::string name, std::string filename, std::string anchor) : inventory(inventory), name(std::move(name)), filename(std::move(filename)), anchor(std::move(anchor)) {}
+
 link_target::module_target::module_target(std::string module) : module(std::move(module)) {}
 
-link_target::uri_target::uri_target(std::string uri) : uri(std::move(uri)) {}
+link_target::uri_target::uri_target(interned_string uri) : uri(uri) {}
 
 type_safe::optional<std::string> link_target::href() const {
   return accept([&](auto&& target) -> type_safe::optional<std::string> {
     using T = std::decay_t<decltype(target)>;
     if constexpr (std::is_same_v<T, uri_target>) {
-      return target.uri;
+      return target.uri.str();
     } else {
       return type_safe::nullopt;
     }
@@ -42,7 +42,7 @@ unordered_entities& unordered_entities::operator=(unordered_entities&& rhs) noex
 }
 
 void unordered_entities::insert(value_type value) {
-  impl_->items.insert(value);
+  impl_->items.insert(std::move(value));
 }
 
 unordered_entities::const_iterator unordered_entities::find_cpp_entity(const cppast::cpp_entity& entity) const {
@@ -209,7 +209,7 @@ size_t unordered_entities::impl::hash::operator()(const entity& self) const {
     if constexpr (std::is_same_v<T, model::cpp_entity_documentation>) {
       return reinterpret_cast<size_t>(&entity.entity());
     } else if constexpr (std::is_same_v<T, model::module>) {
-      return std::hash<std::string>()(entity.name);
+      return std::hash<interned_string>()(entity.name);
     } else {
       return reinterpret_cast<size_t>(self.get());
     }
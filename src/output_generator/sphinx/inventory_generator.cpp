@@ -2,6 +2,7 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <cppast/cpp_entity.hpp>
 #include <cppast/cpp_language_linkage.hpp>
 
 #include "../../../standardese/output_generator/sphinx/inventory_generator.hpp"
@@ -14,54 +15,70 @@
 namespace standardese::output_generator::sphinx
 {
 
-inventory_generator::inventory_generator(std::ostream& os) : stream_generator(os) {}
+inventory_generator::inventory_generator(std::ostream& os) : stream_generator(os), builder(inventory) {}
 
 inventory_generator::~inventory_generator() {
   out_ << inventory << std::flush;
 }
 
 void inventory_generator::visit(document& document) {
+  builder.visit(document);
+}
+
+void inventory_generator::visit(cpp_entity_documentation& documentation) {
+  builder.visit(documentation);
+}
+
+void inventory_generator::visit(group_documentation& documentation) {
+  builder.visit(documentation);
+}
+
+inventory_builder::inventory_builder(inventory::sphinx::documentation_set& inventory) : inventory(inventory) {}
+
+void inventory_builder::visit(document& document) {
   path = document.path;
 
-  stream_generator::visit(document);
+  recursive_visitor::visit(document);
 }
 
-void inventory_generator::visit(cpp_entity_documentation& documentation) {
+void inventory_builder::visit(cpp_entity_documentation& documentation) {
   const auto& entity = documentation.entity();
 
   const auto [domain, type] = domain_type(entity);
   
-  inventory.entries.emplace_back(name(entity), domain, type, priority(entity), path + "/#" + documentation.id, display_name(entity));
+  inventory.entries.emplace_back(name(entity), domain, type, priority(entity), path + "/#" + documentation.id.str(), display_name(entity));
 
-  stream_generator::visit(documentation);
+  recursive_visitor::visit(documentation);
 }
 
-void inventory_generator::visit(group_documentation& documentation) {
+void inventory_builder::visit(group_documentation& documentation) {
   for (const auto& entity : documentation.entities) {
     const auto [domain, type] = domain_type(entity.entity());
     
-    inventory.entries.emplace_back(name(entity.entity()), domain, type, priority(entity.entity()), path + "/#" + documentation.id, display_name(entity.entity()));
-
-    stream_generator::visit(documentation);
+    inventory.entries.emplace_back(name(entity.entity()), domain, type, priority(entity.entity()), path + "/#" + documentation.id.str(), display_name(entity.entity()));
   }
+
+  recursive_visitor::visit(documentation);
 }
 
-int inventory_generator::priority(const cppast::cpp_entity& entity) const {
+int inventory_builder::priority(const cppast::cpp_entity& entity) const {
   // TODO: Any reason to return something else?
   return 0;
 }
 
-std::string inventory_generator::display_name(const cppast::cpp_entity& entity) const {
+std::string inventory_builder::display_name(const cppast::cpp_entity& entity) const {
   // TODO: Make configurable
   return entity.name();
 }
 
-std::string inventory_generator::name(const cppast::cpp_entity& entity) const {
-  // TODO: Fully qualified name
-  return entity.name();
+std::string inventory_builder::name(const cppast::cpp_entity& entity) const {
+  // Entities are recorded with their fully qualified name so that links to
+  // them can be resolved without knowing the scope they were written in,
+  // e.g., when merging the inventories of shards.
+  return cppast::full_name(entity);
 }
 
-std::pair<std::string, std::string> inventory_generator::domain_type(const cppast::cpp_entity& entity) const {
+std::pair<std::string, std::string> inventory_builder::domain_type(const cppast::cpp_entity& entity) const {
   std::string domain = "c++";
 
   {
@@ -155,6 +155,8 @@ void xml_generator::visit(link& link) {
         ;
       } else if constexpr (std::is_same_v<T, model::link_target::sphinx_target>) {
         top.append_attribute("sphinx-target").set_value(target.entry.name.c_str());
+      } else if constexpr (std::is_same_v<T, model::link_target::doxygen_target>) {
+        top.append_attribute("doxygen-target").set_value(target.name.c_str());
       } else {
         throw std::logic_error("not implemented: cannot render this link target type yet");
       }
@@ -355,7 +355,7 @@ void comment_parser::apply_command(cmark_node* node, T& model) const
         {
           auto [name] = command.arguments<1>();
           if (model.id != "")
-              throw parse_error(node, "Cannot set unique name for `{}` to `{}` since it already has a unique name `{}`.", model, name, model.id);
+              throw parse_error(node, "Cannot set unique name for `{}` to `{}` since it already has a unique name `{}`.", model, name, model.id.str());
           model.id = name;
           return;
         }
@@ -409,7 +409,7 @@ void comment_parser::apply_command(cmark_node* node, T& model) const
         {
           auto [module] = command.arguments<1>();
           if constexpr (std::is_same_v<T, model::module>) {
-            throw std::logic_error(fmt::format("Module command can not appear in the module description for `{}`.", model.name));
+            throw std::logic_error(fmt::format("Module command can not appear in the module description for `{}`.", model.name.str()));
           } else {
             if (model.module)
                 throw parse_error(node, "Module cannot be set to `{}` for `{}` since currently each entity can only be in a single module and `{}` is already in the module `{}`.", module, model, model, model.module.value());
@@ -437,7 +437,7 @@ model::entity comment_parser::parse_section(cmark_node* node) const
       visit_children(parent, [&](cmark_node* child) {
         container.add_child(parse(child));
       });
-      return container;
+      return std::move(container);
     };
 
     return parse_into(node, model::section(command.command));
@@ -6,6 +6,14 @@
 #include <cppast/diagnostic.hpp>
 #include <cppast/forward.hpp>
 #include  <type_safe/optional.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <mutex>
+#include <fmt/format.h>
 
 #include "../../standardese/parser/cppast_parser.hpp"
 #include "../../standardese/threading/transform.hpp"
@@ -47,27 +55,237 @@ struct cppast_logger : public cppast::diagnostic_logger {
 
 static cppast_logger logger;
 
+/// Makes the protected `add_flag` of cppast's compile configurations
+/// accessible. cppast only lets us add flags it knows about, such as include
+/// directories, but we need `-include-pch`.
+struct compile_config_access : cppast::compile_config {
+  using cppast::compile_config::add_flag;
+};
+
+void add_flag(cppast::libclang_compile_config& config, std::string flag) {
+  (config.*&compile_config_access::add_flag)(std::move(flag));
+}
+
+/// Return `arg` quoted for the shell.
+std::string quote(const std::string& arg) {
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+  return "\"" + arg + "\"";
+#else
+  std::string quoted = "'";
+  for (char c : arg) {
+    if (c == '\'')
+      quoted += "'\\''";
+    else
+      quoted += c;
+  }
+  return quoted + "'";
+#endif
+}
+
+/// Return the command line that invokes clang with the flags of `config`.
+std::string clang(const cppast::libclang_compile_config& config) {
+  std::string command = quote(cppast::detail::libclang_compile_config_access::clang_binary(config));
+  for (const auto& flag : cppast::detail::libclang_compile_config_access::flags(config))
+    command += " " + quote(flag);
+  return command;
+}
+
+/// Return the prerequisites listed in the Makefile rule that `clang -M`
+/// writes to `in`.
+std::vector<boost::filesystem::path> parse_depfile(std::istream& in) {
+  const std::string rule(std::istreambuf_iterator<char>(in), {});
+
+  std::vector<boost::filesystem::path> prerequisites;
+
+  // Skip the target of the rule.
+  bool target = true;
+  std::string current;
+  const auto flush = [&]() {
+    if (!current.empty() && !target)
+      prerequisites.emplace_back(current);
+    current.clear();
+  };
+
+  for (std::size_t i = 0; i < rule.size(); i++) {
+    const char c = rule[i];
+    if (c == '\\' && i + 1 < rule.size() && (rule[i + 1] == ' ' || rule[i + 1] == '#')) {
+      current += rule[++i];
+    } else if (c == '\\' && i + 1 < rule.size() && (rule[i + 1] == '\n' || rule[i + 1] == '\r')) {
+      // A line continuation.
+      flush();
+    } else if (c == '$' && i + 1 < rule.size() && rule[i + 1] == '$') {
+      current += rule[++i];
+    } else if (c == ':' && target && (i + 1 == rule.size() || rule[i + 1] == ' ' || rule[i + 1] == '\n' || rule[i + 1] == '\r')) {
+      current.clear();
+      target = false;
+    } else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+      flush();
+    } else {
+      current += c;
+    }
+  }
+  flush();
+
+  return prerequisites;
+}
+
 }
 
+/// The precompiled versions of the [options::prelude]().
+struct cppast_parser::preludes {
+  ~preludes() {
+    if (!directory.empty()) {
+      boost::system::error_code ec;
+      boost::filesystem::remove_all(directory, ec);
+    }
+  }
+
+  std::mutex mutex;
+
+  /// The directory holding the precompiled headers.
+  boost::filesystem::path directory;
+
+  /// The precompiled header for each set of flags or nothing if
+  /// precompilation failed for these flags. The header is ready once the
+  /// future is.
+  std::map<std::vector<std::string>, std::shared_future<type_safe::optional<boost::filesystem::path>>> precompiled;
+};
+
 cppast_parser::options::options() {
   // Disable fast preprocessing as it skips header files completely because of
   // their header guards.
   clang_config.fast_preprocessing(false);
 }
 
-cppast_parser::cppast_parser(struct options options) : options(options), parser(cppast::libclang_parser(type_safe::ref(logger))) {
+cppast_parser::cppast_parser(struct options options) : options(options), preludes_(std::make_shared<preludes>()), parser(cppast::libclang_parser(type_safe::ref(logger))) {
   if (options.compile_commands)
     this->compile_commands = cppast::libclang_compilation_database(options.compile_commands.value().generic_string());
 }
 
-const cppast::cpp_file& cppast_parser::parse(const boost::filesystem::path& source) {
-  const auto config = compile_commands.map([&](const cppast::libclang_compilation_database& db) {
+cppast::libclang_compile_config cppast_parser::config(const boost::filesystem::path& source) const {
+  return compile_commands.map([&](const cppast::libclang_compilation_database& db) {
       return cppast::find_config_for(db, source.generic_string());
   }).value_or(options.clang_config);
+}
+
+const cppast::cpp_file& cppast_parser::parse(const boost::filesystem::path& source) {
+  auto config = this->config(source);
+
+  if (options.prelude)
+    config = with_prelude(std::move(config));
 
   return context_.add(parser.parse(context_.index(), boost::filesystem::canonical(source).generic_string(), config));
 }
 
+cppast::libclang_compile_config cppast_parser::with_prelude(cppast::libclang_compile_config config) {
+  const auto& flags = cppast::detail::libclang_compile_config_access::flags(config);
+
+  // Sources are parsed in parallel but we only want to precompile once for
+  // each set of flags. The first source with a new set of flags
+  // precompiles the prelude. Other sources with the same flags wait for it
+  // to finish. Sources with other flags are not affected.
+  std::shared_future<type_safe::optional<boost::filesystem::path>> pch;
+  type_safe::optional<std::promise<type_safe::optional<boost::filesystem::path>>> precompile;
+  boost::filesystem::path output;
+
+  {
+    std::lock_guard lock{preludes_->mutex};
+
+    auto precompiled = preludes_->precompiled.find(flags);
+    if (precompiled != preludes_->precompiled.end()) {
+      pch = precompiled->second;
+    } else {
+      if (preludes_->directory.empty()) {
+        preludes_->directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("standardese-%%%%-%%%%-%%%%");
+        boost::filesystem::create_directories(preludes_->directory);
+      }
+
+      output = preludes_->directory / fmt::format("prelude-{}.pch", preludes_->precompiled.size());
+
+      precompile.emplace();
+      pch = precompile.value().get_future().share();
+      preludes_->precompiled.emplace(flags, pch);
+    }
+  }
+
+  if (precompile) {
+    type_safe::optional<boost::filesystem::path> precompiled;
+
+    try {
+      // The flags might already select a language with -x so we have to
+      // override it after the flags.
+      std::string command = clang(config) + " -x c++-header";
+      command += " " + quote(boost::filesystem::canonical(options.prelude.value()).generic_string());
+      command += " -o " + quote(output.generic_string());
+
+      logger::debug(fmt::format("Precompiling prelude: {}", command));
+
+      if (std::system(command.c_str()) == 0)
+        precompiled = output;
+    } catch (std::exception& e) {
+      logger::debug(e.what());
+    }
+
+    if (!precompiled)
+      logger::warn(fmt::format("Could not precompile prelude {}. Parsing without precompiled prelude.", options.prelude.value().generic_string()));
+
+    precompile.value().set_value(precompiled);
+  }
+
+  if (pch.get()) {
+    add_flag(config, "-include-pch");
+    add_flag(config, pch.get().value().generic_string());
+  }
+
+  return config;
+}
+
+std::vector<std::string> cppast_parser::flags(const boost::filesystem::path& source) const {
+  const auto config = this->config(source);
+  return cppast::detail::libclang_compile_config_access::flags(config);
+}
+
+std::vector<boost::filesystem::path> cppast_parser::dependencies(const boost::filesystem::path& source) const {
+  const auto config = this->config(source);
+
+  const auto depfile = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("standardese-%%%%-%%%%-%%%%.d");
+
+  std::string command = clang(config);
+  command += " -M -MF " + quote(depfile.generic_string());
+  command += " " + quote(boost::filesystem::canonical(source).generic_string());
+
+  logger::debug(fmt::format("Determining dependencies: {}", command));
+
+  const int status = std::system(command.c_str());
+
+  std::ifstream in(depfile.native());
+  auto dependencies = parse_depfile(in);
+  in.close();
+
+  boost::system::error_code ec;
+  boost::filesystem::remove(depfile, ec);
+
+  if (status != 0 || dependencies.empty())
+    throw std::runtime_error(fmt::format("Could not determine the files included by {}.", source.generic_string()));
+
+  for (auto& dependency : dependencies)
+    dependency = boost::filesystem::absolute(dependency);
+
+  return dependencies;
+}
+
+void cppast_parser::preprocess(const boost::filesystem::path& source, const boost::filesystem::path& output) const {
+  std::string command = clang(config(source));
+  command += " -E -dD -dI";
+  command += " " + quote(boost::filesystem::canonical(source).generic_string());
+  command += " -o " + quote(output.generic_string());
+
+  logger::debug(fmt::format("Preprocessing: {}", command));
+
+  if (std::system(command.c_str()) != 0)
+    throw std::runtime_error(fmt::format("Could not preprocess {}.", source.generic_string()));
+}
+
 const cpp_context& cppast_parser::context() const {
   return context_;
 }
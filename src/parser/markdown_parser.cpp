@@ -63,15 +63,15 @@ model::entity markdown_parser::parse(cmark_node* node) const
       visit_children(parent, [&](cmark_node* child) {
         auto parsed = parse(child);
         if constexpr (std::is_same_v<T, model::entity>) {
-          container.add_child(parsed);
+          container.add_child(std::move(parsed));
         } else {
           if (!parsed.is<T>())
             logger::error(fmt::format("Ignoring child node of unexpected type. Cannot add this MarkDown node here: `{}`", cmark_extension::cmark_extension::to_xml(child)));
           else
-            container.add_child(parsed.as<T>());
+            container.add_child(std::move(parsed.as<T>()));
         }
       });
-      return container;
+      return std::move(container);
     };
 
     switch(cmark_node_get_type(node)) {
@@ -0,0 +1,103 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include <fmt/format.h>
+
+#include "../standardese/stats.hpp"
+
+namespace standardese::stats {
+
+namespace {
+
+enum class kind {
+  count,
+  memory,
+  time,
+};
+
+std::mutex mutex;
+
+std::map<std::pair<kind, std::string>, std::size_t> statistics;
+
+/// The counters that currently exist.
+/// Counters are often static objects themselves, so this must be
+/// initialized before the first one is created.
+std::vector<counter*>& counters() {
+  static std::vector<counter*> counters;
+  return counters;
+}
+
+void add(kind kind, const std::string& name, std::size_t value) {
+  std::lock_guard lock{mutex};
+  statistics[{kind, name}] += value;
+}
+
+}
+
+void count(const std::string& name, std::size_t value) {
+  add(kind::count, name, value);
+}
+
+void memory(const std::string& name, std::size_t bytes) {
+  add(kind::memory, name, bytes);
+}
+
+void time(const std::string& name, std::chrono::nanoseconds duration) {
+  add(kind::time, name, duration.count());
+}
+
+timer::timer(std::string name) : name(std::move(name)), start(std::chrono::steady_clock::now()) {}
+
+timer::~timer() {
+  time(name, std::chrono::steady_clock::now() - start);
+}
+
+counter::counter(std::string name) : name(std::move(name)) {
+  std::lock_guard lock{mutex};
+  counters().push_back(this);
+}
+
+counter::~counter() {
+  std::lock_guard lock{mutex};
+  auto& counters = stats::counters();
+  counters.erase(std::remove(counters.begin(), counters.end(), this), counters.end());
+}
+
+void report(std::ostream& out) {
+  std::lock_guard lock{mutex};
+
+  auto statistics = stats::statistics;
+  for (const auto* counter : counters())
+    if (counter->value != 0)
+      statistics[{kind::count, counter->name}] += counter->value;
+
+  for (const auto& [key, value] : statistics) {
+    const auto& [kind, name] = key;
+    switch (kind) {
+      case kind::count:
+        out << fmt::format("{:<48} {:>12}", name, value) << std::endl;
+        break;
+      case kind::memory:
+        out << fmt::format("{:<48} {:>9.1f} KiB", name, value / 1024.) << std::endl;
+        break;
+      case kind::time:
+        out << fmt::format("{:<48} {:>10.3f} s", name, value / 1e9) << std::endl;
+        break;
+    }
+  }
+}
+
+void reset() {
+  std::lock_guard lock{mutex};
+  statistics.clear();
+  for (auto* counter : counters())
+    counter->value = 0;
+}
+
+}
@@ -6,6 +6,10 @@
 
 namespace standardese::threading {
 
+unsigned pool::concurrency() const {
+  return 1;
+}
+
 pool::~pool() {};
 
 }
@@ -78,6 +78,10 @@ std::future<void> threaded_pool::enqueue(std::function<void()> task) {
   return future;
 }
 
+unsigned threaded_pool::concurrency() const {
+  return parallelism;
+}
+
 threaded_pool::~threaded_pool() {
   // Wait for all threads to finish and the task queue to be empty.
   while(true) {
@@ -0,0 +1,261 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "../../standardese/threading/work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace standardese::threading {
+
+namespace {
+
+/// The worker of a [work_stealing_pool]() that is running on this thread.
+struct current_worker {
+  const void* pool = nullptr;
+  std::size_t index = 0;
+};
+
+thread_local current_worker current;
+
+}
+
+struct work_stealing_pool::deque::buffer {
+  explicit buffer(std::int64_t capacity) : capacity(capacity), tasks(new std::atomic<task*>[capacity]) {}
+
+  task* get(std::int64_t i) const { return tasks[i & (capacity - 1)].load(std::memory_order_acquire); }
+
+  void put(std::int64_t i, task* t) { tasks[i & (capacity - 1)].store(t, std::memory_order_release); }
+
+  // Must be a power of two.
+  const std::int64_t capacity;
+
+  std::unique_ptr<std::atomic<task*>[]> tasks;
+};
+
+work_stealing_pool::deque::deque() : top(0), bottom(0), tasks(new buffer(64)) {}
+
+work_stealing_pool::deque::~deque() {
+  delete tasks.load();
+}
+
+work_stealing_pool::deque::buffer* work_stealing_pool::deque::grow(buffer* current, std::int64_t top, std::int64_t bottom) {
+  auto* grown = new buffer(2 * current->capacity);
+  for (auto i = top; i < bottom; i++)
+    grown->put(i, current->get(i));
+
+  retired.emplace_back(current);
+  tasks.store(grown, std::memory_order_release);
+  return grown;
+}
+
+void work_stealing_pool::deque::push(task* t) {
+  const auto b = bottom.load(std::memory_order_relaxed);
+  const auto t0 = top.load(std::memory_order_acquire);
+  auto* a = tasks.load(std::memory_order_relaxed);
+
+  if (b - t0 > a->capacity - 1)
+    a = grow(a, t0, b);
+
+  a->put(b, t);
+  bottom.store(b + 1, std::memory_order_release);
+}
+
+work_stealing_pool::task* work_stealing_pool::deque::pop() {
+  const auto b = bottom.load(std::memory_order_relaxed) - 1;
+  auto* a = tasks.load(std::memory_order_relaxed);
+  bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto t = top.load(std::memory_order_relaxed);
+
+  if (t > b) {
+    // The deque was empty.
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  task* ret = a->get(b);
+  if (t == b) {
+    // This is the last task, we might be racing a thief for it.
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      ret = nullptr;
+    bottom.store(b + 1, std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+work_stealing_pool::task* work_stealing_pool::deque::steal() {
+  auto t = top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const auto b = bottom.load(std::memory_order_acquire);
+
+  if (t >= b)
+    return nullptr;
+
+  auto* a = tasks.load(std::memory_order_acquire);
+  task* ret = a->get(t);
+  if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    // Lost the race against another thief or the owner.
+    return nullptr;
+
+  return ret;
+}
+
+bool work_stealing_pool::deque::empty() const {
+  return top.load(std::memory_order_acquire) >= bottom.load(std::memory_order_acquire);
+}
+
+work_stealing_pool::work_stealing_pool(int parallelism) {
+  if (parallelism <= 0)
+    parallelism = std::thread::hardware_concurrency() + 1;
+
+  for (int i = 0; i < parallelism; i++)
+    queues.emplace_back(new deque());
+
+  for (int i = 0; i < parallelism; i++)
+    threads.emplace_back([this, i]{ work(i); });
+}
+
+pool::factory work_stealing_pool::factory(int parallelism) {
+  return [parallelism]() { return std::unique_ptr<pool>(new work_stealing_pool(parallelism)); };
+}
+
+std::future<void> work_stealing_pool::enqueue(std::function<void()> task) {
+  if (!accepting)
+    throw std::logic_error("Cannot enqueue tasks to stopped worker pool.");
+
+  auto* package = new work_stealing_pool::task(std::move(task));
+  auto future = package->get_future();
+
+  pending++;
+
+  if (current.pool == this) {
+    // Tasks spawned by one of our workers go to that worker's deque. Other
+    // workers steal them if the worker cannot keep up.
+    queues[current.index]->push(package);
+  } else {
+    std::lock_guard lock{injected_mutex};
+    injected.push_back(package);
+  }
+
+  notify();
+
+  return future;
+}
+
+unsigned work_stealing_pool::concurrency() const {
+  return threads.size();
+}
+
+void work_stealing_pool::notify() {
+  // Pairs with the fence in work() so that either we see the sleeping worker
+  // or the worker sees the task we just enqueued.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (sleeping.load(std::memory_order_relaxed) == 0)
+    return;
+
+  std::lock_guard lock{sleep_mutex};
+  task_enqueued.notify_one();
+}
+
+work_stealing_pool::task* work_stealing_pool::take(std::size_t worker) {
+  std::lock_guard lock{injected_mutex};
+
+  if (injected.empty())
+    return nullptr;
+
+  // Take a fair share of the injected tasks so that we do not have to come
+  // back to the lock for every single task. The other workers can steal
+  // them from us if we took too many.
+  const auto batch = std::max<std::size_t>(1, injected.size() / queues.size());
+
+  auto* ret = injected.front();
+  injected.pop_front();
+
+  for (std::size_t i = 1; i < batch; i++) {
+    queues[worker]->push(injected.front());
+    injected.pop_front();
+  }
+
+  return ret;
+}
+
+work_stealing_pool::task* work_stealing_pool::next(std::size_t worker) {
+  if (auto* t = queues[worker]->pop())
+    return t;
+
+  if (auto* t = take(worker))
+    return t;
+
+  for (std::size_t i = 1; i < queues.size(); i++) {
+    if (auto* t = queues[(worker + i) % queues.size()]->steal())
+      return t;
+  }
+
+  return nullptr;
+}
+
+void work_stealing_pool::work(std::size_t worker) {
+  current = {this, worker};
+
+  while (true) {
+    if (auto* t = next(worker)) {
+      // Run the task. Note that this cannot throw. Any exceptions are stored
+      // in the future that was created in enqueue.
+      (*t)();
+      delete t;
+
+      if (--pending == 0) {
+        std::lock_guard lock{sleep_mutex};
+        task_completed.notify_all();
+      }
+
+      continue;
+    }
+
+    std::unique_lock lock{sleep_mutex};
+
+    if (!accepting)
+      // Destructor has been called and there is nothing left to do.
+      break;
+
+    sleeping++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Check again for work now that notify() is going to see us sleeping.
+    bool idle = true;
+    {
+      std::lock_guard injected_lock{injected_mutex};
+      idle = injected.empty();
+    }
+    for (const auto& queue : queues)
+      idle = idle && queue->empty();
+
+    if (idle)
+      task_enqueued.wait(lock);
+
+    sleeping--;
+  }
+
+  current = {};
+}
+
+work_stealing_pool::~work_stealing_pool() {
+  {
+    // Wait for all tasks to complete.
+    std::unique_lock lock{sleep_mutex};
+    task_completed.wait(lock, [&]() { return pending == 0; });
+
+    accepting = false;
+  }
+
+  // Wake up all threads, so that they see accepting=false and exit.
+  task_enqueued.notify_all();
+
+  // Clean up the threads.
+  for (auto& thread : threads) thread.join();
+}
+
+}
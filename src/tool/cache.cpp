@@ -0,0 +1,197 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <fstream>
+#include <map>
+#include <boost/filesystem/operations.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "../../standardese/tool/cache.hpp"
+#include "../../standardese/threading/transform.hpp"
+#include "../../standardese/logger.hpp"
+
+#ifndef STANDARDESE_VERSION_MAJOR
+#define STANDARDESE_VERSION_MAJOR "?"
+#endif
+
+#ifndef STANDARDESE_VERSION_MINOR
+#define STANDARDESE_VERSION_MINOR "?"
+#endif
+
+namespace standardese::tool {
+
+namespace {
+
+/// Bump this whenever the manifest format changes.
+constexpr int manifest_version = 2;
+
+/// The version of standardese that produced the outputs.
+std::string version() {
+  return fmt::format("{}.{}", STANDARDESE_VERSION_MAJOR, STANDARDESE_VERSION_MINOR);
+}
+
+/// Return whether `source` is parsed as C/C++ code.
+bool is_cpp(const boost::filesystem::path& source) {
+  return boost::filesystem::extension(source) != ".md";
+}
+
+/// Return the compiler flags of each of the C/C++ sources of `parser`.
+std::map<std::string, std::vector<std::string>> flags(const parsers::options& parser) {
+  const parser::cppast_parser cppast_parser(parser.cppast_options);
+
+  std::map<std::string, std::vector<std::string>> flags;
+  for (const auto& source : parser.sources)
+    if (is_cpp(source))
+      flags[source.generic_string()] = cppast_parser.flags(source);
+  return flags;
+}
+
+boost::filesystem::path manifest(const boost::filesystem::path& directory) {
+  return directory / "manifest.json";
+}
+
+/// Return hashes for all the `files` or an empty hash for files that cannot
+/// be read.
+std::map<std::string, std::string> hashes(const std::vector<boost::filesystem::path>& files) {
+  std::map<std::string, std::string> hashes;
+  for (const auto& file : files)
+    hashes[file.generic_string()] = boost::filesystem::exists(file) ? cache::hash(file) : "";
+  return hashes;
+}
+
+/// Return whether the files recorded in `recorded` still have the same
+/// hashes.
+bool unchanged(const nlohmann::json& recorded) {
+  for (const auto& [path, hash] : recorded.items()) {
+    const auto current = boost::filesystem::exists(path) ? cache::hash(path) : "";
+    if (current != hash.get<std::string>()) {
+      logger::info(fmt::format("{} changed since the last run.", path));
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+cache::cache(struct options options) : options(std::move(options)) {}
+
+bool cache::up_to_date(const parsers::options& parser) const {
+  if (options.directory.empty())
+    return false;
+
+  std::ifstream in(manifest(options.directory).native());
+  if (!in)
+    return false;
+
+  nlohmann::json recorded;
+  try {
+    in >> recorded;
+  } catch (nlohmann::json::exception& e) {
+    logger::warn(fmt::format("Ignoring unreadable cache manifest {}: {}", manifest(options.directory).generic_string(), e.what()));
+    return false;
+  }
+
+  if (recorded.value("version", 0) != manifest_version)
+    return false;
+
+  if (recorded.value("standardese", "") != version()) {
+    logger::info("Version of standardese changed since the last run.");
+    return false;
+  }
+
+  if (recorded.value("configuration", "") != options.configuration) {
+    logger::info("Configuration changed since the last run.");
+    return false;
+  }
+
+  if (recorded["flags"] != nlohmann::json(flags(parser))) {
+    logger::info("Compiler flags changed since the last run.");
+    return false;
+  }
+
+  return unchanged(recorded["inputs"]) && unchanged(recorded["outputs"]);
+}
+
+std::vector<boost::filesystem::path> cache::inputs(const parsers::options& parser, threading::pool& workers) const {
+  if (options.directory.empty())
+    return {};
+
+  auto inputs = options.inputs;
+  inputs.insert(inputs.end(), parser.sources.begin(), parser.sources.end());
+
+  // A source needs to be parsed again when any of the files it includes
+  // change, directly or indirectly.
+  const parser::cppast_parser cppast_parser(parser.cppast_options);
+
+  std::vector<boost::filesystem::path> sources;
+  std::copy_if(parser.sources.begin(), parser.sources.end(), std::back_inserter(sources), is_cpp);
+
+  for (const auto& dependencies : threading::transform(workers, sources.begin(), sources.end(), [&](const auto& source) -> std::vector<boost::filesystem::path> {
+    // Failing to determine the dependencies only means that we cannot cache
+    // this run, so this must not be reported as an error.
+    try {
+      return cppast_parser.dependencies(source);
+    } catch (std::exception& e) {
+      logger::debug(e.what());
+      return {};
+    }
+  }, 1)) {
+    // We cannot tell when this run is outdated if we do not know what a
+    // source includes.
+    if (dependencies.empty()) {
+      logger::warn("Not caching this run since the files included by some sources could not be determined.");
+      return {};
+    }
+    inputs.insert(inputs.end(), dependencies.begin(), dependencies.end());
+  }
+
+  std::sort(inputs.begin(), inputs.end());
+  inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+
+  return inputs;
+}
+
+void cache::record(const parsers::options& parser, const std::vector<boost::filesystem::path>& inputs, const std::vector<boost::filesystem::path>& outputs) const {
+  if (options.directory.empty() || inputs.empty())
+    return;
+
+  nlohmann::json record;
+  record["version"] = manifest_version;
+  record["standardese"] = version();
+  record["configuration"] = options.configuration;
+  record["flags"] = flags(parser);
+  record["inputs"] = hashes(inputs);
+  record["outputs"] = hashes(outputs);
+
+  boost::filesystem::create_directories(options.directory);
+  std::ofstream out(manifest(options.directory).native());
+  out << record.dump(2) << std::endl;
+
+  if (!out)
+    logger::warn(fmt::format("Could not write cache manifest {}.", manifest(options.directory).generic_string()));
+}
+
+std::string cache::hash(const boost::filesystem::path& path) {
+  std::ifstream in(path.native(), std::ios::binary);
+
+  // 64-bit FNV-1a
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+
+  char buffer[1 << 16];
+  while (in.read(buffer, sizeof(buffer)) || in.gcount()) {
+    for (std::streamsize i = 0; i < in.gcount(); i++) {
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 0x100000001b3ull;
+    }
+  }
+
+  return fmt::format("{:016x}", hash);
+}
+
+}
@@ -3,9 +3,11 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <optional>
 #include <fmt/format.h>
 #include <cppast/cpp_file.hpp>
 #include <nlohmann/json.hpp>
+#include <type_safe/optional.hpp>
 
 #include "../../standardese/tool/document_builders.hpp"
 #include "../../standardese/model/unordered_entities.hpp"
@@ -13,6 +15,8 @@
 #include "../../standardese/document_builder/entity_document_builder.hpp"
 #include "../../standardese/model/document.hpp"
 #include "../../standardese/formatter/inja_formatter.hpp"
+#include "../../standardese/threading/unthreaded_pool.hpp"
+#include "../../standardese/threading/transform.hpp"
 #include "../../standardese/logger.hpp"
 
 namespace standardese::tool {
@@ -20,36 +24,52 @@ namespace standardese::tool {
 document_builders::document_builders(struct options options) : options(std::move(options)) {}
 
 model::unordered_entities document_builders::create(model::unordered_entities& parsed) {
+  threading::unthreaded_pool workers;
+  return create(parsed, workers);
+}
+
+model::unordered_entities document_builders::create(model::unordered_entities& parsed, threading::pool& workers, model::arenas* arenas) {
   // TODO: Make configurable. We presently only build for header files in fixed formats.
 
   auto builder = document_builder::entity_document_builder();
 
   model::unordered_entities documents;
 
-  formatter::inja_formatter formatter{{}};
+  std::vector<const model::entity*> files;
 
-  logger::info("Creating entity documents.");
   for (auto& entity : parsed) {
     if (entity.is<model::cpp_entity_documentation>()) {
-      auto& documentation = entity.as<model::cpp_entity_documentation>();
-
-      formatter::inja_formatter inja{{}};
-      inja.data().merge_patch(inja.to_json(documentation.entity()));
-
-      if (cppast::cpp_file::kind() == documentation.entity().kind()) {
-        logger::debug(fmt::format("Creating document for entity {}.", documentation.entity().name()));
-
-        const std::string name = inja.format(options.document_name);
-        const std::string path = inja.format(options.document_path);
-
-        documents.insert(builder.build(name, path, entity, parsed));
-      }
+      if (cppast::cpp_file::kind() == entity.as<model::cpp_entity_documentation>().entity().kind())
+        files.push_back(&entity);
     }
     if (entity.is<model::document>()) {
-      documents.insert(entity);
+      documents.insert(entity.clone());
     }
   }
 
+  logger::info("Creating entity documents.");
+  auto built = threading::transform(workers, files.begin(), files.end(), [&](const model::entity* entity) {
+    auto& documentation = entity->as<model::cpp_entity_documentation>();
+
+    formatter::inja_formatter inja{{}};
+    inja.data().merge_patch(inja.to_json(documentation.entity()));
+
+    logger::debug(fmt::format("Creating document for entity {}.", documentation.entity().name()));
+
+    const std::string name = inja.format(options.document_name);
+    const std::string path = inja.format(options.document_path);
+
+    std::optional<model::arena::scope> allocate_in_arena;
+    if (arenas)
+      allocate_in_arena.emplace(arenas->create());
+
+    return type_safe::optional<model::document>(builder.build(name, path, *entity, parsed));
+  });
+
+  for (auto& document : built)
+    if (document.has_value())
+      documents.insert(std::move(document.value()));
+
   // TODO: Build index files.
 
   // TODO: Make sure document names/paths are unique.
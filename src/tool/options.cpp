@@ -18,7 +18,9 @@
 #include <iostream>
 #include <cstdlib>
 #include <regex>
+#include <sstream>
 #include <stdexcept>
+#include <variant>
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
 #include <spdlog/logger.h>
@@ -322,6 +324,23 @@ void options_parser::parse(int argc, const char* argv[]) {
     process_doxygen_options(parsed);
     process_intersphinx_options(parsed);
     process_positional_options(parsed);
+
+    // Anything on the command line can change the output.
+    for (int i = 1; i < argc; i++)
+      options.cache_options.configuration += std::string(argv[i]) + "\n";
+
+    if (options.parser_options.cppast_options.compile_commands)
+      options.cache_options.inputs.push_back(options.parser_options.cppast_options.compile_commands.value() / "compile_commands.json");
+
+    if (options.parser_options.cppast_options.prelude)
+      options.cache_options.inputs.push_back(options.parser_options.cppast_options.prelude.value());
+
+    for (const auto& external : options.transformation_options.external_link_options)
+      std::visit([&](const auto& external) {
+        using T = std::decay_t<decltype(external)>;
+        if constexpr (!std::is_same_v<T, transformations::options::external_legacy_options>)
+          options.cache_options.inputs.push_back(external.inventory);
+      }, external);
   } catch(std::exception& e) {
     if (options.options_options.throw_on_error)
       throw;
@@ -384,7 +403,13 @@ po::options_description options_parser::generic_options() const {
   generic.add_options()
         ("config,c", po::value<fs::path>()->value_name("FILE"), "Read additional options from config file.")
         ("warn-as-error,W", po::bool_switch(), "Treat warnings as errors.")
-        ("verbose,v", po::value<counter>()->zero_tokens(), "Print verbose messages.");
+        ("verbose,v", po::value<counter>()->zero_tokens(), "Print verbose messages.")
+        ("stats", po::bool_switch(), "Print statistics about the time and memory spent on the run.")
+        ("arena", po::bool_switch(), "Allocate the entities parsed from each source and each output document in large blocks that are only released at the end of the run.")
+        ("jobs,j", po::value<int>()->value_name("N"), "Run N worker threads in parallel; defaults to one more than the number of CPUs.")
+        ("cache", po::value<fs::path>()->value_name("DIR"), "Record inputs and outputs in DIR and skip the next run if none of them changed.")
+        ("shard", po::value<std::string>()->value_name("K/N"), "Only process the K-th of N disjoint subsets of the sources. Links to other shards are resolved by --merge.")
+        ("merge", po::value<std::vector<fs::path>>()->value_name("DIR"), "Do not parse anything but merge the outputs of shards written to DIR into the output directory; can be specified multiple times.");
 
   if (options.options_options.include_cli_options) {
     generic.add_options()
@@ -433,6 +458,41 @@ void options_parser::process_generic_options(po::variables_map& parsed) {
   if (parsed.at("warn-as-error").as<bool>()) {
     logger::warn_as_error();
   }
+
+  options.stats = parsed.at("stats").as<bool>();
+
+  options.arena = parsed.at("arena").as<bool>();
+
+  if (parsed.count("jobs"))
+    options.parser_options.parallelism = parsed.at("jobs").as<int>();
+
+  if (parsed.count("cache")) {
+    options.cache_options.directory = parsed.at("cache").as<fs::path>();
+    options.transformation_options.inventory_cache = options.cache_options.directory / "inventories";
+  }
+
+  if (parsed.count("config"))
+    options.cache_options.inputs.push_back(parsed.at("config").as<fs::path>());
+
+  if (parsed.count("shard")) {
+    const auto shard = parsed.at("shard").as<std::string>();
+
+    unsigned index, count;
+    char separator;
+    std::istringstream in(shard);
+    if (!(in >> index >> separator >> count) || separator != '/' || !in.eof() || index < 1 || index > count)
+      throw std::invalid_argument(fmt::format("--shard must be of the form K/N with 1 <= K <= N but found `{}`.", shard));
+
+    options.shard_options.index = index - 1;
+    options.shard_options.count = count;
+
+    // Links into other shards can only be resolved when merging.
+    if (count > 1)
+      options.transformation_options.unresolved_options.defer = shards::deferred;
+  }
+
+  if (parsed.count("merge"))
+    options.shard_options.merge = parsed.at("merge").as<std::vector<fs::path>>();
 }
 
 po::options_description options_parser::legacy_input_options() const {
@@ -679,6 +739,8 @@ po::options_description options_parser::cpp_parser_options() const {
   compiler.add_options()
     (",I", po::value<std::vector<std::string>>()->value_name("dir"), "Add directory to be searched for header files.")
     ("std", po::value<cppast::cpp_standard>()->default_value(cppast::cpp_standard::cpp_14), "The C++ standard to use for parsing.")
+    ("prelude", po::value<fs::path>()->value_name("header"), "Precompile this header once and load it into every source before parsing; list the heavy headers that most sources include here.")
+    ("shared-prelude", po::value<bool>()->default_value(false)->implicit_value(true)->zero_tokens(), "Unless --prelude is given, precompile the system headers that more than one source includes before anything else as a prelude.")
     // Note that this is handled in process_markdown_parser_options() because
     // it actually does not affect the C++ parser.
     ("free-file-comments", po::value<bool>()->default_value(false)->implicit_value(true)->zero_tokens(), "Associate free comments to their header file.");
@@ -695,6 +757,12 @@ void options_parser::process_cpp_parser_options(po::variables_map& parsed) {
   if (parsed.count("std")) {
     options.parser_options.cppast_options.clang_config.set_flags(parsed.at("std").as<cppast::cpp_standard>());
   }
+
+  if (parsed.count("prelude")) {
+    options.parser_options.cppast_options.prelude = parsed.at("prelude").as<fs::path>();
+  }
+
+  options.parser_options.shared_prelude = parsed.at("shared-prelude").as<bool>();
 }
 
 po::options_description options_parser::markdown_parser_options() const {
@@ -6,6 +6,10 @@
 #include <boost/filesystem/operations.hpp>
 #include <stdexcept>
 #include <fstream>
+#include <sstream>
+#include <utility>
+#include <fmt/format.h>
+#include <iterator>
 
 #include "../../standardese/tool/output_generators.hpp"
 #include "../../standardese/model/unordered_entities.hpp"
@@ -13,13 +17,45 @@
 #include "../../standardese/output_generator/markdown/markdown_generator.hpp"
 #include "../../standardese/output_generator/xml/xml_generator.hpp"
 #include "../../standardese/output_generator/sphinx/inventory_generator.hpp"
+#include "../../standardese/threading/unthreaded_pool.hpp"
+#include "../../standardese/threading/transform.hpp"
 #include "../../standardese/logger.hpp"
 
 namespace standardese::tool {
 
 output_generators::output_generators(struct options options) : options(options) {}
 
-void output_generators::emit(model::unordered_entities& documents) {
+namespace {
+
+/// Write `content` to `path` unless the file already has exactly this
+/// content. Leaving unchanged files alone keeps their timestamps so that
+/// whatever processes our output next does not need to redo its work.
+void write(const boost::filesystem::path& path, const std::string& content) {
+  if (boost::filesystem::exists(path) && boost::filesystem::file_size(path) == content.size()) {
+    std::ifstream in(path.native(), std::ios::binary);
+    std::string existing(std::istreambuf_iterator<char>(in), {});
+    if (existing == content) {
+      logger::debug(fmt::format("Not writing {} since it did not change.", path.generic_string()));
+      return;
+    }
+  }
+
+  boost::filesystem::create_directories(path.parent_path());
+  std::ofstream out(path.native(), std::ios::binary);
+  out << content;
+
+  if (!out)
+    logger::error(fmt::format("Failed to write {}.", path.generic_string()));
+}
+
+}
+
+std::vector<boost::filesystem::path> output_generators::emit(model::unordered_entities& documents) {
+  threading::unthreaded_pool workers;
+  return emit(documents, workers);
+}
+
+std::vector<boost::filesystem::path> output_generators::emit(model::unordered_entities& documents, threading::pool& workers) {
   /*
   for (auto& document : documents) {
     std::ofstream out("TODO.xml");
@@ -28,24 +64,49 @@ void output_generators::emit(model::unordered_entities& documents) {
   }
   */
 
-  const auto open = [&](const boost::filesystem::path& path) {
-    boost::filesystem::create_directories(path.parent_path());
-    return std::ofstream{path};
-  };
+  std::vector<boost::filesystem::path> outputs;
 
-  for (auto& document : documents) {
-    auto out = open(options.output_directory / (document.as<model::document>().name + ".md"));
-    auto generator = output_generator::markdown::markdown_generator{out};
-    document.accept(generator);
-  }
+  // Render each document and collect its part of the inventory in the same
+  // task on the pool. The inventory builder walks the document a second
+  // time, but only while the document is still hot in this worker's cache,
+  // and no serial walk over all documents is needed afterwards.
+  auto rendered = threading::transform(workers, documents.begin(), documents.end(), [&](auto& document) {
+    const auto path = options.output_directory / (document.template as<model::document>().name.str() + ".md");
+
+    {
+      std::stringstream out;
+      {
+        auto generator = output_generator::markdown::markdown_generator{out};
+        document.accept(generator);
+      }
+      write(path, out.str());
+    }
 
+    inventory::sphinx::documentation_set inventory;
+    auto builder = output_generator::sphinx::inventory_builder{inventory};
+    document.accept(builder);
+    return std::pair{path, std::move(inventory)};
+  }, 1);
+
+  // Merge the partial inventories in the order of the documents, so that
+  // the resulting inventory does not depend on the scheduling of the tasks.
   {
-    auto out = open(options.output_directory / "objects.inv");
-    auto generator = output_generator::sphinx::inventory_generator{out};
-    for (auto& document : documents) {
-      document.accept(generator);
+    inventory::sphinx::documentation_set inventory;
+    for (auto& [path, partial] : rendered) {
+      outputs.push_back(path);
+      inventory.entries.insert(inventory.entries.end(), std::make_move_iterator(partial.entries.begin()), std::make_move_iterator(partial.entries.end()));
     }
+
+    const auto path = options.output_directory / "objects.inv";
+
+    std::stringstream out;
+    out << inventory << std::flush;
+    write(path, out.str());
+
+    outputs.push_back(path);
   }
+
+  return outputs;
 }
 
 }
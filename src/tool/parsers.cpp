@@ -5,17 +5,31 @@
 
 #include <cppast/cpp_entity.hpp>
 #include <cppast/visitor.hpp>
+#include <type_safe/optional.hpp>
 #include <type_safe/optional_ref.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <optional>
+#include <set>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "../../standardese/tool/parsers.hpp"
 #include "../../standardese/model/unordered_entities.hpp"
 #include "../../standardese/model/document.hpp"
-#include "../../standardese/threading/threaded_pool.hpp"
+#include "../../standardese/threading/work_stealing_pool.hpp"
 #include "../../standardese/threading/transform.hpp"
 #include "../../standardese/parser/comment_collector.hpp"
+#include "../../standardese/logger.hpp"
 
 namespace standardese::tool {
 
@@ -31,98 +45,516 @@ std::vector<T> flatten(R&& ranges) {
   return flattened;
 }
 
+/// Return `sources` without duplicates, i.e., without sources that resolve
+/// to the same file as an earlier source.
+std::vector<boost::filesystem::path> unique(const std::vector<boost::filesystem::path>& sources) {
+  std::vector<boost::filesystem::path> unique;
+  std::unordered_set<std::string> seen;
+
+  for (const auto& source : sources) {
+    boost::system::error_code ec;
+    auto canonical = boost::filesystem::canonical(source, ec);
+    if (!seen.insert((ec ? source : canonical).generic_string()).second) {
+      logger::debug(fmt::format("Not parsing {} again.", source.generic_string()));
+      continue;
+    }
+    unique.push_back(source);
+  }
+
+  return unique;
+}
+
+/// The `#include` directives of a source file as reported by the
+/// preprocessor.
+struct preprocessed {
+  /// A `#include <...>` directive of a system header at the top of the
+  /// source that could be moved into a prelude.
+  struct include {
+    /// The header as it is spelled in the directive.
+    std::string header;
+
+    /// The canonical paths of all the files that the preprocessor entered
+    /// while it processed this header, including the header itself.
+    std::set<std::string> files;
+  };
+
+  /// The system headers that the source includes before anything else in
+  /// the order in which they are included.
+  std::vector<include> leading;
+
+  /// The canonical paths of all the files that the preprocessor entered
+  /// after the leading includes. If such a file is included by a prelude,
+  /// the preprocessor skips it here, so it might see different macros.
+  std::set<std::string> late;
+
+  /// Read the output of [parser::cppast_parser::preprocess]() line by line.
+  /// The leading includes end with the first macro definition,
+  /// declaration, or include of a header that is not a system header.
+  static preprocessed read(std::istream& in) {
+    preprocessed result;
+
+    // The main file, i.e., the source itself.
+    std::string main;
+
+    // The files that the preprocessor is currently in, outermost first.
+    std::vector<std::string> files;
+
+    // The header spelled in the last `#include <...>` of the main file if
+    // the preprocessor has not entered it yet.
+    type_safe::optional<std::string> spelled;
+
+    // Whether the main file has only included system headers so far.
+    bool leading = true;
+
+    // Where to record the files that the preprocessor enters.
+    std::set<std::string>* current = nullptr;
+
+    // The canonical paths of the files seen so far.
+    std::unordered_map<std::string, std::string> canonicals;
+    const auto canonical = [&](const std::string& file) -> const std::string& {
+      auto search = canonicals.find(file);
+      if (search == canonicals.end()) {
+        boost::system::error_code ec;
+        const auto path = boost::filesystem::canonical(file, ec);
+        search = canonicals.emplace(file, ec ? file : path.generic_string()).first;
+      }
+      return search->second;
+    };
+
+    std::string line;
+    while (std::getline(in, line)) {
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+      std::string file;
+      std::string flags;
+      if (marker(line, file, flags)) {
+        if (files.empty()) {
+          main = file;
+          files.push_back(file);
+        } else if (flags.find('1') != std::string::npos) {
+          if (files.size() == 1) {
+            // Ignore <built-in> and <command line> and what they include.
+            if (files.back() != main || file[0] == '<') {
+              current = nullptr;
+            } else {
+              leading = leading && spelled.has_value() && flags.find('3') != std::string::npos;
+              if (leading) {
+                result.leading.push_back({spelled.value(), {}});
+                current = &result.leading.back().files;
+              } else {
+                current = &result.late;
+              }
+              spelled = type_safe::nullopt;
+            }
+          }
+
+          files.push_back(file);
+
+          if (current != nullptr)
+            current->insert(canonical(file));
+        } else if (flags.find('2') != std::string::npos) {
+          if (files.size() > 1)
+            files.pop_back();
+          files.back() = file;
+        } else {
+          files.back() = file;
+        }
+        continue;
+      }
+
+      // Skip everything that is not in the main file, including the
+      // predefined macros in <built-in>.
+      if (!leading || files.size() != 1 || files.back() != main)
+        continue;
+
+      if (line.find_first_not_of(" \t") == std::string::npos || directive(line, "pragma"))
+        continue;
+
+      std::string header;
+      if (directive(line, "include") && angled(line, header))
+        spelled = header;
+      else if (!directive(line, "include"))
+        leading = false;
+    }
+
+    return result;
+  }
+
+ private:
+  /// Return whether `line` is a line marker `# linenum "file" flags...` and
+  /// extract the `file` and the `flags`.
+  static bool marker(const std::string& line, std::string& file, std::string& flags) {
+    if (line.size() < 4 || line[0] != '#' || line[1] != ' ' || !std::isdigit(static_cast<unsigned char>(line[2])))
+      return false;
+
+    std::size_t i = 2;
+    while (i < line.size() && std::isdigit(static_cast<unsigned char>(line[i])))
+      i++;
+
+    if (line.compare(i, 2, " \"") != 0)
+      return false;
+
+    for (i += 2; i < line.size() && line[i] != '"'; i++) {
+      if (line[i] == '\\' && i + 1 < line.size())
+        i++;
+      file += line[i];
+    }
+
+    if (i == line.size())
+      return false;
+
+    flags = line.substr(i + 1);
+    return true;
+  }
+
+  /// Return whether `line` is the preprocessor directive `name`.
+  static bool directive(const std::string& line, const std::string& name) {
+    std::size_t i = line.find_first_not_of(" \t");
+    if (i == std::string::npos || line[i] != '#')
+      return false;
+    i = line.find_first_not_of(" \t", i + 1);
+    return i != std::string::npos && line.compare(i, name.size(), name) == 0 && (i + name.size() == line.size() || !(std::isalnum(static_cast<unsigned char>(line[i + name.size()])) || line[i + name.size()] == '_'));
+  }
+
+  /// Return whether the `#include` directive in `line` includes a header
+  /// with `<...>` and extract that `header`.
+  static bool angled(const std::string& line, std::string& header) {
+    const auto include = line.find("include");
+    const auto begin = line.find_first_not_of(" \t", include + 7);
+    if (begin == std::string::npos || line[begin] != '<')
+      return false;
+    const auto end = line.find('>', begin);
+    if (end == std::string::npos)
+      return false;
+    header = line.substr(begin + 1, end - begin - 1);
+    return true;
+  }
+};
+
+/// A header that includes the system headers that at least two of the
+/// sources include before anything else. The header is deleted again when
+/// this object goes out of scope.
+/// The headers are determined by running the preprocessor on each source,
+/// so only the includes that the preprocessor actually follows count.
+/// Since the prelude is loaded before every source, a header is not shared
+/// if any of the files it includes is also included by some source after
+/// that source defined a macro or included a header of its own. Also, a
+/// source that is included by the prelude would be skipped because of its
+/// include guard when we parse it, so no header that leads to a source is
+/// shared.
+struct shared_prelude {
+  shared_prelude(const std::vector<boost::filesystem::path>& sources, const parser::cppast_parser& parser, threading::pool& workers) {
+    std::vector<boost::filesystem::path> cpp;
+    for (const auto& source : sources) {
+      if (boost::filesystem::extension(source) == ".md")
+        continue;
+      cpp.push_back(source);
+
+      boost::system::error_code ec;
+      const auto canonical = boost::filesystem::canonical(source, ec);
+      late.insert((ec ? source : canonical).generic_string());
+    }
+
+    // Collect the files below each header in a single table since most
+    // sources include the same system headers.
+    std::mutex mutex;
+    std::map<std::string, std::set<std::string>> files;
+
+    const auto includes = threading::transform(workers, cpp.begin(), cpp.end(), [&](const auto& source) {
+      std::vector<std::string> headers;
+
+      // A source that cannot be preprocessed does not suggest any headers
+      // for the prelude. Its failure is reported when it is parsed.
+      preprocessed scanned;
+      try {
+        scanned = scan(parser, source);
+      } catch (std::exception& e) {
+        logger::warn(fmt::format("Not considering {} for the shared prelude: {}", source.generic_string(), e.what()));
+        return headers;
+      }
+
+      std::lock_guard lock{mutex};
+      for (auto& include : scanned.leading) {
+        headers.push_back(include.header);
+        files[include.header].merge(include.files);
+      }
+      late.merge(scanned.late);
+
+      return headers;
+    }, 1);
+
+    std::set<std::string> excluded;
+    for (const auto& [header, below] : files)
+      if (!is_safe(below))
+        excluded.insert(header);
+
+    // A header is only shared if at least two sources include it before
+    // any header that is not shared. Since dropping a header can make
+    // other headers unshared, repeat until nothing changes.
+    std::vector<std::string> shared;
+    while (true) {
+      std::map<std::string, int> count;
+      std::vector<std::string> order;
+      for (const auto& leading : includes) {
+        for (const auto& header : leading) {
+          if (excluded.count(header))
+            break;
+          if (count[header]++ == 0)
+            order.push_back(header);
+        }
+      }
+
+      bool changed = false;
+      shared.clear();
+      for (const auto& header : order) {
+        if (count[header] < 2) {
+          changed |= excluded.insert(header).second;
+          continue;
+        }
+        shared.push_back(header);
+      }
+
+      if (!changed)
+        break;
+    }
+
+    // Make sure that the prelude itself is safe. The headers might include
+    // different files when they are included in a different order.
+    while (!shared.empty()) {
+      write(shared);
+
+      preprocessed prelude;
+      try {
+        prelude = scan(parser, path);
+      } catch (std::exception& e) {
+        logger::warn(fmt::format("Not using a shared prelude: {}", e.what()));
+        shared.clear();
+        break;
+      }
+
+      const auto before = shared.size();
+      for (const auto& include : prelude.leading)
+        if (!is_safe(include.files))
+          shared.erase(std::remove(shared.begin(), shared.end(), include.header), shared.end());
+
+      if (!prelude.late.empty()) {
+        // The prelude has not been read completely, e.g., because one of
+        // the shared headers is not a system header anymore.
+        shared.clear();
+      }
+
+      if (shared.size() == before)
+        break;
+    }
+
+    if (shared.empty()) {
+      remove();
+      return;
+    }
+
+    logger::info(fmt::format("Using a shared prelude of {} headers.", shared.size()));
+  }
+
+  ~shared_prelude() {
+    remove();
+  }
+
+  /// The generated header or empty if no header is shared.
+  boost::filesystem::path path;
+
+ private:
+  /// Return the includes of `source` as reported by the preprocessor.
+  static preprocessed scan(const parser::cppast_parser& parser, const boost::filesystem::path& source) {
+    const auto output = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("standardese-%%%%-%%%%-%%%%.i");
+
+    preprocessed scanned;
+    try {
+      parser.preprocess(source, output);
+
+      std::ifstream in(output.native());
+      scanned = preprocessed::read(in);
+    } catch (...) {
+      boost::system::error_code ec;
+      boost::filesystem::remove(output, ec);
+      throw;
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::remove(output, ec);
+
+    return scanned;
+  }
+
+  /// Return whether a header that leads to `files` can be moved into the
+  /// prelude.
+  bool is_safe(const std::set<std::string>& files) const {
+    return std::none_of(files.begin(), files.end(), [&](const auto& file) { return late.count(file); });
+  }
+
+  /// Write a prelude that includes the `headers`.
+  void write(const std::vector<std::string>& headers) {
+    if (path.empty())
+      path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("standardese-prelude-%%%%-%%%%.hpp");
+
+    std::ofstream out(path.native());
+    for (const auto& header : headers)
+      out << "#include <" << header << ">" << std::endl;
+  }
+
+  void remove() {
+    if (!path.empty()) {
+      boost::system::error_code ec;
+      boost::filesystem::remove(path, ec);
+      path.clear();
+    }
+  }
+
+  /// The sources and the files that a source includes after its leading
+  /// system headers.
+  std::set<std::string> late;
+};
+
 }
 
 parsers::parsers(struct options options) : options(options) {}
 
 std::pair<model::unordered_entities, parser::cpp_context> parsers::parse() {
-  // Configure Worker Pool
-  auto workers = threading::threaded_pool::factory(options.parallelism);
+  threading::work_stealing_pool workers{options.parallelism};
+  return parse(workers);
+}
 
+std::pair<model::unordered_entities, parser::cpp_context> parsers::parse(threading::pool& workers, model::arenas* arenas) {
   // TODO: Split sources when parsing into C - C++ - Markdown?
 
-  // Parse C/C++ source code.
-  auto cpp_parser = parser::cppast_parser(options.cppast_options);
-  auto parsed = threading::transform(workers, options.sources.begin(), options.sources.end(), [&](const auto& header) -> type_safe::optional<type_safe::object_ref<const cppast::cpp_file>> {
-    if (boost::filesystem::extension(header) == ".md")
-      return {};
-    return type_safe::ref(cpp_parser.parse(header));
-  });
+  // Parse every file only once, even if it has been listed several times.
+  const auto sources = unique(options.sources);
 
-  // Drop files that failed to parse.
-  decltype(parsed) successfully_parsed;
-  for (auto& cpp_file : parsed)
-    if (cpp_file.has_value())
-      successfully_parsed.emplace_back(std::move(cpp_file));
+  auto cppast_options = options.cppast_options;
 
-  // Collect source code comments.
-  auto comment_collector = parser::comment_collector(options.comment_collector_options);
-  auto comments = flatten(threading::transform(workers, successfully_parsed.begin(), successfully_parsed.end(), [&](const auto& cpp_file) {
-      return comment_collector.collect(*cpp_file.value());
-  }));
+  // Parse headers that are included by many sources only once.
+  type_safe::optional<shared_prelude> prelude;
+  if (options.shared_prelude && !cppast_options.prelude) {
+    prelude.emplace(sources, parser::cppast_parser(cppast_options), workers);
+    if (!prelude->path.empty())
+      cppast_options.prelude = prelude->path;
+  }
 
-  // Parse comments as MarkDown...
+  auto cpp_parser = parser::cppast_parser(cppast_options);
+  auto comment_collector = parser::comment_collector(options.comment_collector_options);
   auto comment_parser = parser::comment_parser(options.comment_parser_options, cpp_parser.context());
+  parser::markdown_parser markdown_parser;
 
-  // ...first process comments that are next to entities and cannot contain an
-  // `\entity` command.
-  auto entities = flatten(threading::transform(workers, comments.begin(), comments.end(), [&](const auto& comment_with_entity) -> std::vector<model::entity> {
-    if (std::get<1>(comment_with_entity)->kind() == cppast::cpp_file::kind())
-      return {};
+  /// What we learn from a single source file before we have seen all the
+  /// other source files.
+  struct parsed_source {
+    type_safe::optional<type_safe::object_ref<const cppast::cpp_file>> cpp_file;
 
-    const auto resolve_entity = [](const std::string&) -> type_safe::optional_ref<const cppast::cpp_entity> {
-      throw std::logic_error(R"(not implemented: entity comment should not invoke an entity lookup since \entity commands are illegal in such comments.)");
-    };
+    /// Comments that are attached to the file itself. These can contain
+    /// `\entity` commands and can only be parsed once all sources are done.
+    std::vector<parser::comment_collector::comment> file_comments;
 
-    return comment_parser.parse(std::get<0>(comment_with_entity), *std::get<1>(comment_with_entity), resolve_entity);
-  }));
+    /// The arena that the entities of this file are allocated in, if any.
+    model::arena* arena = nullptr;
 
-  // ...now we have seen all the relevant `\unique_name` commands and can
-  // safely resolve `\entity` commands and merge with what we have so far.
-  entities = flatten(std::vector{
-    flatten(threading::transform(workers, comments.begin(), comments.end(), [&](const auto& comment_with_file) -> std::vector<model::entity> {
-        if (std::get<1>(comment_with_file)->kind() != cppast::cpp_file::kind())
-          return {};
+    /// The entities created from the comments that could be parsed right
+    /// away, or the document created from a MarkDown file.
+    std::vector<model::entity> entities;
+  };
 
-        const auto resolve_entity = [](const std::string&) -> type_safe::optional_ref<const cppast::cpp_entity> {
-          throw std::logic_error(R"(not implemented: resole_entity in tool::parsers.)");
-        };
+  // Stream each source file through the parsing stages. A file moves on to
+  // comment collection and comment parsing as soon as libclang is done with
+  // it, so a few slow files do not hold up the others. Files vary a lot in
+  // size so we handle each file in a task of its own.
+  auto parsed_sources = threading::transform(workers, sources.begin(), sources.end(), [&](const auto& source) {
+    parsed_source parsed;
 
-        return comment_parser.parse(std::get<0>(comment_with_file), *std::get<1>(comment_with_file), resolve_entity);
-    })),
-    std::move(entities),
-  });
+    std::optional<model::arena::scope> allocate_in_arena;
+    if (arenas) {
+      parsed.arena = &arenas->create();
+      allocate_in_arena.emplace(*parsed.arena);
+    }
 
-  // Parse MarkDown files.
-  parser::markdown_parser markdown_parser;
-
-  auto mds = threading::transform(workers, options.sources.begin(), options.sources.end(), [&](const auto& md) {
-      if (boost::filesystem::extension(md) != ".md")
-        return type_safe::optional<model::entity>();
-      std::ifstream in(md.native());
+    if (boost::filesystem::extension(source) == ".md") {
+      // Parse MarkDown files.
+      std::ifstream in(source.native());
       std::string raw(std::istreambuf_iterator<char>(in), {});
       auto doc = markdown_parser.parse(raw);
       // TODO: This is a hack.
       /*
-      doc.name = md.native();
+      doc.name = source.native();
       if (doc.name.find_last_of('/') != std::string::npos)
         doc.name = doc.name.substr(doc.name.find_last_of('/') + 1);
       if (doc.name.find_first_of('.') != std::string::npos)
         doc.name = doc.name.substr(0, doc.name.find_first_of('.'));
       */
-      return type_safe::optional<model::entity>(doc);
-  });
+      parsed.entities.emplace_back(std::move(doc));
+      return parsed;
+    }
+
+    // Parse C/C++ source code.
+    const auto& cpp_file = cpp_parser.parse(source);
+    parsed.cpp_file = type_safe::ref(cpp_file);
+
+    // Collect source code comments and parse the ones that are next to
+    // entities as MarkDown. These cannot contain an `\entity` command.
+    for (auto& comment : comment_collector.collect(cpp_file)) {
+      if (std::get<1>(comment)->kind() == cppast::cpp_file::kind()) {
+        parsed.file_comments.emplace_back(std::move(comment));
+        continue;
+      }
+
+      const auto resolve_entity = [](const std::string&) -> type_safe::optional_ref<const cppast::cpp_entity> {
+        throw std::logic_error(R"(not implemented: entity comment should not invoke an entity lookup since \entity commands are illegal in such comments.)");
+      };
+
+      // A broken comment should not take down the other comments in this file.
+      try {
+        for (auto& entity : comment_parser.parse(std::get<0>(comment), *std::get<1>(comment), resolve_entity))
+          parsed.entities.emplace_back(std::move(entity));
+      } catch (std::exception& e) {
+        logger::error(e.what());
+      }
+    }
+
+    return parsed;
+  }, 1);
+
+  // Drop files that failed to parse.
+  std::vector<type_safe::object_ref<const cppast::cpp_file>> successfully_parsed;
+  std::vector<std::pair<parser::comment_collector::comment, model::arena*>> file_comments;
+  for (auto& source : parsed_sources) {
+    if (source.cpp_file.has_value())
+      successfully_parsed.emplace_back(source.cpp_file.value());
+    for (auto& comment : source.file_comments)
+      file_comments.emplace_back(std::move(comment), source.arena);
+  }
+
+  // Now we have seen all the relevant `\unique_name` commands and can
+  // safely resolve `\entity` commands and merge with what we have so far.
+  auto entities = flatten(threading::transform(workers, file_comments.begin(), file_comments.end(), [&](const auto& comment_in_arena) -> std::vector<model::entity> {
+      const auto& [comment_with_file, arena] = comment_in_arena;
+
+      const auto resolve_entity = [](const std::string&) -> type_safe::optional_ref<const cppast::cpp_entity> {
+        throw std::logic_error(R"(not implemented: resole_entity in tool::parsers.)");
+      };
+
+      std::optional<model::arena::scope> allocate_in_arena;
+      if (arena)
+        allocate_in_arena.emplace(*arena);
+
+      return comment_parser.parse(std::get<0>(comment_with_file), *std::get<1>(comment_with_file), resolve_entity);
+  }));
 
-  for (auto& md : mds)
-    if (md)
-      entities.emplace_back(std::move(md.value()));
+  for (auto& source : parsed_sources)
+    entities.insert(entities.end(), std::make_move_iterator(source.entities.begin()), std::make_move_iterator(source.entities.end()));
 
   // Merge entities.
-  auto ret = model::unordered_entities(entities);
+  auto ret = model::unordered_entities(std::move(entities));
 
   // TODO: Is this really what we should do? And should we do this here?
   for (auto& cpp_file : successfully_parsed)
-    comment_parser.add_uncommented_entities(ret, *cpp_file.value());
+    comment_parser.add_uncommented_entities(ret, *cpp_file);
 
   return {std::move(ret), cpp_parser.context()};
 }
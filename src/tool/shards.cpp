@@ -0,0 +1,245 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <boost/filesystem/operations.hpp>
+#include <fmt/format.h>
+#include <type_safe/optional.hpp>
+
+#include "../../standardese/tool/shards.hpp"
+#include "../../standardese/inventory/symbols.hpp"
+#include "../../standardese/inventory/sphinx/documentation_set.hpp"
+#include "../../standardese/logger.hpp"
+
+namespace standardese::tool {
+
+namespace {
+
+/// Return a hash of `value` that is the same on all platforms, unlike
+/// `std::hash`.
+std::uint64_t hash(const std::string& value) {
+  // 64-bit FNV-1a
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  for (char c : value) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+std::string read(const boost::filesystem::path& path) {
+  std::ifstream in(path.native(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+/// Write `content` to `path` unless the file already has exactly this
+/// content.
+void write(const boost::filesystem::path& path, const std::string& content) {
+  if (boost::filesystem::exists(path) && read(path) == content)
+    return;
+
+  boost::filesystem::create_directories(path.parent_path());
+  std::ofstream out(path.native(), std::ios::binary);
+  out << content;
+
+  if (!out)
+    logger::error(fmt::format("Failed to write {}.", path.generic_string()));
+}
+
+/// Return `url` escaped as the destination of a MarkDown link.
+std::string escape(const std::string& url) {
+  std::string escaped;
+  for (char c : url) {
+    if (c == '(' || c == ')' || c == '<' || c == '>' || c == '`' || c == '\\' || std::isspace(static_cast<unsigned char>(c)))
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+/// Return the position of the `[` that opens the text of the MarkDown link
+/// whose text is closed by the `]` at `close`, or `npos` if there is no such
+/// `[` at or after `begin`.
+std::size_t link_text(const std::string& markdown, std::size_t begin, std::size_t close) {
+  const auto escaped = [&](std::size_t position) {
+    std::size_t backslashes = 0;
+    while (position - backslashes > begin && markdown[position - backslashes - 1] == '\\')
+      backslashes++;
+    return backslashes % 2 == 1;
+  };
+
+  std::size_t depth = 0;
+  for (auto position = close; position-- > begin;) {
+    if (escaped(position))
+      continue;
+
+    if (markdown[position] == ']') {
+      depth++;
+    } else if (markdown[position] == '[') {
+      if (depth == 0)
+        return position;
+      depth--;
+    }
+  }
+
+  return std::string::npos;
+}
+
+/// Replace the destinations of all MarkDown links in `markdown` that start
+/// with the `prefix` with whatever `lookup` returns for the remainder of
+/// the destination. When `lookup` returns nothing, the link is replaced by
+/// its text.
+template <typename Lookup>
+std::string resolve(const std::string& markdown, const std::string& prefix, Lookup&& lookup) {
+  const std::string opening = "](" + prefix;
+
+  std::string resolved;
+  std::size_t position = 0;
+
+  while (true) {
+    const auto start = markdown.find(opening, position);
+    if (start == std::string::npos)
+      break;
+
+    // Read the destination up to the closing parenthesis, undoing the
+    // escaping of the MarkDown renderer.
+    std::string target;
+    auto end = start + opening.size();
+    for (; end < markdown.size() && markdown[end] != ')'; end++) {
+      if (markdown[end] == '\\' && end + 1 < markdown.size())
+        end++;
+      target += markdown[end];
+    }
+
+    const auto destination = lookup(target);
+    const auto text = destination ? std::string::npos : link_text(markdown, position, start);
+
+    if (text == std::string::npos) {
+      resolved.append(markdown, position, start - position);
+      resolved += "](" + escape(destination.value_or(target));
+      position = end;
+    } else {
+      // Drop the brackets and the destination of the link but keep its text.
+      resolved.append(markdown, position, text - position);
+      resolved.append(markdown, text + 1, start - text - 1);
+      position = std::min(end + 1, markdown.size());
+    }
+  }
+
+  resolved.append(markdown, position, std::string::npos);
+  return resolved;
+}
+
+}
+
+const std::string shards::deferred = "standardese-deferred://";
+
+shards::shards(struct options options) : options(std::move(options)) {}
+
+std::vector<boost::filesystem::path> shards::select(const std::vector<boost::filesystem::path>& sources) const {
+  if (options.count <= 1)
+    return sources;
+
+  std::vector<boost::filesystem::path> selected;
+  for (const auto& source : sources)
+    if (hash(source.lexically_normal().generic_string()) % options.count == options.index)
+      selected.push_back(source);
+
+  logger::info(fmt::format("Shard {} of {} parses {} of {} sources.", options.index + 1, options.count, selected.size(), sources.size()));
+
+  return selected;
+}
+
+std::vector<boost::filesystem::path> shards::merge(const boost::filesystem::path& output_directory) const {
+  std::vector<boost::filesystem::path> outputs;
+
+  // Combine the inventories of all the shards.
+  inventory::sphinx::documentation_set inventory;
+  for (const auto& shard : options.merge) {
+    const auto path = shard / "objects.inv";
+    if (!boost::filesystem::exists(path)) {
+      logger::error(fmt::format("Shard {} has no inventory {}.", shard.generic_string(), path.generic_string()));
+      continue;
+    }
+
+    auto partial = inventory::sphinx::documentation_set::parse(path.native());
+    if (inventory.entries.empty()) {
+      inventory.project = partial.project;
+      inventory.version = partial.version;
+    }
+    inventory.entries.insert(inventory.entries.end(), std::make_move_iterator(partial.entries.begin()), std::make_move_iterator(partial.entries.end()));
+  }
+
+  const auto symbols = inventory::symbols(inventory);
+
+  // Copy the outputs of the shards and resolve the links that the shards
+  // deferred to us.
+  std::map<boost::filesystem::path, boost::filesystem::path> merged;
+  for (const auto& shard : options.merge) {
+    if (!boost::filesystem::is_directory(shard))
+      continue;
+
+    for (const auto& file : boost::filesystem::recursive_directory_iterator(shard)) {
+      if (!boost::filesystem::is_regular_file(file.path()))
+        continue;
+
+      const auto relative = file.path().lexically_relative(shard);
+      if (relative == "objects.inv")
+        continue;
+
+      if (!merged.emplace(relative, shard).second) {
+        logger::warn(fmt::format("Both {} and {} contain {}. Ignoring the latter.", merged[relative].generic_string(), shard.generic_string(), relative.generic_string()));
+        continue;
+      }
+
+      auto content = read(file.path());
+
+      if (file.path().extension() == ".md") {
+        // Like the links that cannot be resolved in a single run, the links
+        // that no shard can resolve are left without a destination.
+        content = resolve(content, deferred, [&](const std::string& target) -> type_safe::optional<std::string> {
+          auto search = symbols.find(target);
+          if (!search) {
+            logger::warn(fmt::format("Could not resolve link target `{}`.", target));
+            return type_safe::nullopt;
+          }
+
+          return search.value().accept([&](auto&& resolved) -> type_safe::optional<std::string> {
+            using T = std::decay_t<decltype(resolved)>;
+            if constexpr (std::is_same_v<T, model::link_target::sphinx_target>) {
+              return "/" + resolved.entry.uri;
+            } else {
+              logger::warn(fmt::format("Link target `{}` does not resolve to a page of the merged shards.", target));
+              return type_safe::nullopt;
+            }
+          });
+        });
+      }
+
+      const auto path = output_directory / relative;
+      write(path, content);
+      outputs.push_back(path);
+    }
+  }
+
+  {
+    const auto path = output_directory / "objects.inv";
+
+    std::stringstream out;
+    out << inventory << std::flush;
+    write(path, out.str());
+
+    outputs.push_back(path);
+  }
+
+  return outputs;
+}
+
+}
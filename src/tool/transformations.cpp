@@ -3,11 +3,16 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <functional>
+#include <memory>
 #include <stdexcept>
 #include <variant>
+#include <fmt/format.h>
 
 #include "../../standardese/tool/transformations.hpp"
 #include "../../standardese/model/unordered_entities.hpp"
+#include "../../standardese/inventory/sphinx/mapped_documentation_set.hpp"
+#include "../../standardese/inventory/doxygen/mapped_tagfile_index.hpp"
 #include "../../standardese/transformation/entity_heading_transformation.hpp"
 #include "../../standardese/transformation/synopsis_transformation.hpp"
 #include "../../standardese/transformation/exclude_uncommented_transformation.hpp"
@@ -18,53 +23,156 @@
 #include "../../standardese/transformation/link_target_unresolved_transformation.hpp"
 #include "../../standardese/transformation/link_href_internal_transformation.hpp"
 #include "../../standardese/transformation/link_sphinx_transformation.hpp"
+#include "../../standardese/transformation/link_doxygen_transformation.hpp"
 #include "../../standardese/transformation/group_uncommented_transformation.hpp"
 #include "../../standardese/transformation/group_transformation.hpp"
+#include "../../standardese/transformation/pipeline.hpp"
+#include "../../standardese/threading/unthreaded_pool.hpp"
+#include "../../standardese/tool/cache.hpp"
+#include "../../standardese/stats.hpp"
+#include "../../standardese/logger.hpp"
 
 namespace standardese::tool {
 
 template<class> inline constexpr bool always_false_v = false;
 
+namespace {
+
+/// Load the intersphinx inventory at `path` and record its size in the
+/// statistics.
+/// If a cache `directory` is given, the inventory is mapped from a binary
+/// copy in that directory. The copy is named after the hash of the contents
+/// of `path` and written the first time these contents are loaded.
+std::variant<inventory::sphinx::documentation_set, inventory::sphinx::mapped_documentation_set> load(const boost::filesystem::path& path, const boost::filesystem::path& directory) {
+  stats::timer timer{"link inventory: load external inventories"};
+
+  if (directory.empty()) {
+    auto inventory = inventory::sphinx::documentation_set::parse(path.native());
+    stats::count("link inventory: external entries", inventory.entries.size());
+    return inventory;
+  }
+
+  const auto hash = cache::hash(path);
+  const auto binary = directory / (hash + ".inv");
+
+  auto mapped = inventory::sphinx::mapped_documentation_set::open(binary, hash);
+  if (!mapped) {
+    logger::debug(fmt::format("Creating binary copy {} of inventory {}.", binary.generic_string(), path.generic_string()));
+
+    auto inventory = inventory::sphinx::documentation_set::parse(path.native());
+    stats::count("link inventory: external entries", inventory.entries.size());
+
+    try {
+      inventory::sphinx::mapped_documentation_set::write(binary, inventory, hash);
+    } catch (std::exception& e) {
+      logger::warn(fmt::format("Could not cache inventory {}: {}", path.generic_string(), e.what()));
+      return inventory;
+    }
+
+    mapped = inventory::sphinx::mapped_documentation_set::open(binary, hash);
+    if (!mapped)
+      return inventory;
+  } else {
+    stats::count("link inventory: external entries", mapped.value().size());
+  }
+
+  return std::move(mapped.value());
+}
+
+/// Index the doxygen tagfile at `path` and record its size in the
+/// statistics.
+/// If a cache `directory` is given, the index is mapped from a binary copy
+/// in that directory like in [load]().
+std::variant<inventory::doxygen::tagfile_index, inventory::doxygen::mapped_tagfile_index> load_tagfile(const boost::filesystem::path& path, const boost::filesystem::path& directory) {
+  stats::timer timer{"link inventory: load external inventories"};
+
+  if (directory.empty()) {
+    auto index = inventory::doxygen::tagfile_index::parse(path.native());
+    stats::count("link inventory: external entries", index.size());
+    return index;
+  }
+
+  const auto hash = cache::hash(path);
+  const auto binary = directory / (hash + ".tag");
+
+  auto mapped = inventory::doxygen::mapped_tagfile_index::open(binary, hash);
+  if (!mapped) {
+    logger::debug(fmt::format("Creating binary copy {} of the index of tagfile {}.", binary.generic_string(), path.generic_string()));
+
+    auto index = inventory::doxygen::tagfile_index::parse(path.native());
+    stats::count("link inventory: external entries", index.size());
+
+    try {
+      inventory::doxygen::mapped_tagfile_index::write(binary, index, hash);
+    } catch (std::exception& e) {
+      logger::warn(fmt::format("Could not cache tagfile {}: {}", path.generic_string(), e.what()));
+      return index;
+    }
+
+    mapped = inventory::doxygen::mapped_tagfile_index::open(binary, hash);
+    if (!mapped)
+      return index;
+  } else {
+    stats::count("link inventory: external entries", mapped.value().size());
+  }
+
+  return std::move(mapped.value());
+}
+
+}
+
 transformations::transformations(struct options options) : options(options) {}
 
 void transformations::transform(model::unordered_entities& documents, const parser::cpp_context& context) {
+  threading::unthreaded_pool workers;
+  transform(documents, context, workers);
+}
+
+void transformations::transform(model::unordered_entities& documents, const parser::cpp_context& context, threading::pool& workers) {
   // TODO: Make this configurable
 
-  // TODO: Use parallel worker pool.
+  using dependency = transformation::pipeline::dependency;
+
+  transformation::pipeline pipeline{documents};
 
   // Resolve Links in Standardese Syntax to Internal Targets
-  transformation::link_target_internal_transformation{documents, context}.transform();
+  pipeline.emplace<transformation::link_target_internal_transformation>(dependency::all_documents, std::cref(context));
 
   // Resolve Links in Standardese Syntax to External Targets
   for (auto& option : options.external_link_options)
     std::visit([&](const auto& external) {
       using T = std::decay_t<decltype(external)>;
       if constexpr (std::is_same_v<T, options::external_sphinx_options>) {
-        transformation::link_sphinx_transformation{documents, external.options, inventory::sphinx::documentation_set::parse(external.inventory.native())}.transform();
+        std::visit([&](auto&& inventory) {
+          pipeline.emplace<transformation::link_sphinx_transformation>(dependency::document, external.options, std::move(inventory));
+        }, load(external.inventory, options.inventory_cache));
       } else if constexpr (std::is_same_v<T, options::external_doxygen_options>) {
-        // TODO: implement me.
-        throw std::logic_error("not implemented: doxygen linking");
+        std::visit([&](auto&& inventory) {
+          pipeline.emplace<transformation::link_doxygen_transformation>(dependency::document, external.options, std::move(inventory));
+        }, load_tagfile(external.inventory, options.inventory_cache));
       } else if constexpr (std::is_same_v<T, options::external_legacy_options>) {
-        transformation::link_external_legacy_transformation{documents, external.options}.transform();
+        pipeline.emplace<transformation::link_external_legacy_transformation>(dependency::document, external.options);
         throw std::logic_error("not implemented: legacy linking");
       } else {
         static_assert(always_false_v<T>, "unhandled external documentation link type");
       }
     }, option);
-  transformation::link_target_unresolved_transformation{documents}.transform();
+  pipeline.emplace<transformation::link_target_unresolved_transformation>(dependency::document, options.unresolved_options);
 
-  transformation::group_uncommented_transformation{documents, options.group_uncommented_options}.transform();
+  pipeline.emplace<transformation::group_uncommented_transformation>(dependency::document, options.group_uncommented_options);
 
-  transformation::group_transformation{documents, options.group_options}.transform();
+  pipeline.emplace<transformation::group_transformation>(dependency::document, options.group_options);
 
-  transformation::exclude_uncommented_transformation{documents, options.exclude_uncommented_options}.transform();
-  transformation::synopsis_transformation{documents}.transform();
-  transformation::entity_heading_transformation{documents, options.entity_heading_options}.transform();;
-  transformation::output_group_transformation{documents}.transform();
-  transformation::anchor_transformation{documents}.transform();
+  pipeline.emplace<transformation::exclude_uncommented_transformation>(dependency::document, options.exclude_uncommented_options);
+  pipeline.emplace<transformation::synopsis_transformation>(dependency::document);
+  pipeline.emplace<transformation::entity_heading_transformation>(dependency::document, options.entity_heading_options);
+  pipeline.emplace<transformation::output_group_transformation>(dependency::document);
+  pipeline.emplace<transformation::anchor_transformation>(dependency::document);
 
-  // Resolve Links to the actual URLs
-  transformation::link_href_internal_transformation{documents}.transform();
-}
+  // Resolve Links to the actual URLs. This needs the anchors of all the
+  // documents to be final.
+  pipeline.emplace<transformation::link_href_internal_transformation>(dependency::all_documents);
 
+  pipeline.transform(workers);
+}
 }
@@ -2,62 +2,72 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
-#include <sstream>
-#include <regex>
+#include <cctype>
+#include <string>
+#include <string_view>
 
 #include "../../standardese/transformation/anchor_transformation.hpp"
 #include "../../standardese/model/mixin/anchored.hpp"
 #include "../../standardese/model/unordered_entities.hpp"
-#include "../../standardese/model/visitor/visit.hpp"
+#include "../../standardese/model/flat_document.hpp"
 
 namespace standardese::transformation {
 
+std::string anchor_transformation::slug(std::string_view text) {
+  std::string slug;
+  slug.reserve(text.size());
+
+  bool separator = false;
+  for (const unsigned char c : text) {
+    if (c == '-' || c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r') {
+      separator = true;
+    } else if ((c < 0x80 && std::isalnum(c)) || c == '_') {
+      if (separator)
+        slug += '-';
+      separator = false;
+      slug += static_cast<char>(std::tolower(c));
+    }
+  }
+
+  if (separator)
+    slug += '-';
+
+  return slug;
+}
+
 void anchor_transformation::do_transform(model::entity& document) {
-  std::string path;
-
-  model::visitor::visit([&](auto&& entity, auto&& recurse) {
-    using T = std::decay_t<decltype(entity)>;
-    if constexpr (std::is_base_of_v<model::document, T>) {
-      // TODO
-      // path = entity.path;
-    } else if constexpr (std::is_base_of_v<model::mixin::anchored, T>) {
-      // TODO: We are using knowledge about mkdocs here. Instead we should
-      // offer several implementations here:
-      // * render a preceding <a>
-      // * render the first element manually as HTML and add an id
-      // * Render some MarkDown extension {}
-      // * Render for mkdocs/hugo/...
-
-      // TODO: Anyway, what mkdocs does is not a bad strategy in general: https://github.com/Python-Markdown/markdown/blob/master/markdown/extensions/toc.py#L26
-      
-      // TODO: Complain when the anchor is not unique (and offer a solution?)
-
-      // TODO: What can we do when there is no heading?
-      if (entity.begin() != entity.end() && entity.begin()->template is<model::markup::heading>()) {
-        auto& heading = entity.begin()->template as<model::markup::heading>();
-
-        std::string inner;
-        model::visitor::visit([&](auto&& node, auto&& recurse) {
-          using T = std::decay_t<decltype(node)>;
-          if constexpr (std::is_same_v<T, model::markup::text>) {
-            inner += node.value;
-          }
-          recurse();
-        }, heading);
+  using model::flat_document;
+
+  const flat_document<> flat(document);
+
+  for (flat_document<>::index node = 0; node < flat.size(); node++) {
+    // TODO: What can we do when there is no heading?
+    const auto heading = flat.first_child(node);
+    if (heading == flat_document<>::none || flat.kind(heading) != model::node_kind::heading)
+      continue;
+
+    flat.visit(node, [&](auto& entity) {
+      using T = std::decay_t<decltype(entity)>;
+      if constexpr (std::is_base_of_v<model::document, T>) {
+        // TODO
+        // path = entity.path;
+      } else if constexpr (std::is_base_of_v<model::mixin::anchored, T>) {
+        // TODO: We are using knowledge about mkdocs here. Instead we should
+        // offer several implementations here:
+        // * render a preceding <a>
+        // * render the first element manually as HTML and add an id
+        // * Render some MarkDown extension {}
+        // * Render for mkdocs/hugo/...
+
+        // TODO: Anyway, what mkdocs does is not a bad strategy in general: https://github.com/Python-Markdown/markdown/blob/master/markdown/extensions/toc.py#L26
         
-        std::regex strip(R"([^\w\s-])");
-        std::regex escape(R"([-\s]+)");
-        inner = std::regex_replace(inner, strip, "");
-        std::transform(inner.begin(), inner.end(), inner.begin(), [](unsigned char c){ return std::tolower(c); });
-        inner = std::regex_replace(inner, escape, "-");
-        // TODO: Additionally, mkdocs sometimes adds _number to make things unique.
+        // TODO: Complain when the anchor is not unique (and offer a solution?)
 
-        entity.id = inner;
+        // TODO: Additionally, mkdocs sometimes adds _number to make things unique.
+        entity.id = slug(flat.text(heading));
       }
-    }
-
-    recurse();
-  }, document);
+    });
+  }
 }
 
 }
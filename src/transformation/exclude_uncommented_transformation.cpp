@@ -9,6 +9,7 @@
 #include "../../standardese/transformation/exclude_uncommented_transformation.hpp"
 #include "../../standardese/model/visitor/recursive_visitor.hpp"
 #include "../../standardese/model/visitor/generic_visitor.hpp"
+#include "../../standardese/model/visitor/visit.hpp"
 #include "../../standardese/model/entity.hpp"
 #include "../../standardese/model/cpp_entity_documentation.hpp"
 #include "../../standardese/logger.hpp"
@@ -41,7 +42,7 @@ struct visitor : model::visitor::generic_visitor<visitor, model::visitor::recurs
   void operator()(T& entity);
 
   std::stack<bool> empty;
-  std::stack<std::vector<model::entity>> containers;
+  model::visitor::rebuilt_containers containers;
 
   const struct exclude_uncommented_transformation::options& options;
 };
@@ -58,7 +59,6 @@ void exclude_uncommented_transformation::do_transform(model::entity& document) {
 namespace {
 
 visitor::visitor(const struct exclude_uncommented_transformation::options& options) : options(options) {
-  containers.push({});
   push();
 }
 
@@ -159,15 +159,13 @@ void visitor::operator()(T& entity) {
 
   push();
 
-  containers.push({});
-  model::visitor::recursive_visitor<false>::visit(entity);
-
   if constexpr (std::is_base_of_v<model::mixin::container<>, T>) {
-    entity.clear();
-    for (auto& child : containers.top())
-      entity.emplace_child(std::move(child));
+    containers.enter();
+    model::visitor::recursive_visitor<false>::visit(entity);
+    containers.leave(entity);
+  } else {
+    model::visitor::recursive_visitor<false>::visit(entity);
   }
-  containers.pop();
 
   if constexpr (std::is_same_v<T, model::cpp_entity_documentation>) {
     switch (exclude(mode(entity.entity()), empty.top(), entity.exclude_mode)) {
@@ -184,7 +182,7 @@ void visitor::operator()(T& entity) {
         break;
     }
   } else {
-    containers.top().emplace_back(entity);
+    containers.keep(std::move(entity));
   }
 
   if constexpr (std::is_same_v<T, model::markup::block_quote>
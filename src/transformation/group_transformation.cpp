@@ -3,9 +3,6 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
-#include <stack>
-#include <vector>
-
 #include "../../standardese/transformation/group_transformation.hpp"
 
 #include "../../standardese/model/group_documentation.hpp"
@@ -16,20 +13,15 @@ namespace standardese::transformation {
 group_transformation::group_transformation(model::unordered_entities& documents, group_options options) : transformation(documents), options(std::move(options)) {}
 
 void group_transformation::do_transform(model::entity& document) {
-  std::stack<std::vector<model::entity>> containers;
-  containers.push({});
+  model::visitor::rebuilt_containers containers;
 
   model::visitor::visit([&](auto&& entity, auto&& recurse) {
     using T = std::decay_t<decltype(entity)>;
 
     if constexpr (std::is_base_of_v<model::mixin::container<>, T>) {
-      containers.push({});
-
+      containers.enter();
       recurse();
-
-      entity.clear();
-      for (auto& child : containers.top()) entity.emplace_child(std::move(child));
-      containers.pop();
+      containers.leave(entity);
     }
 
     if constexpr (std::is_same_v<T, model::cpp_entity_documentation>) {
@@ -53,7 +45,7 @@ void group_transformation::do_transform(model::entity& document) {
       }
     }
 
-    containers.top().emplace_back(entity);
+    containers.keep(std::move(entity));
   }, document);
 }
 
@@ -6,12 +6,14 @@
 #include <fmt/format.h>
 #include <unordered_map>
 #include <stack>
+#include <utility>
 
 #include <cppast/cpp_entity.hpp>
 #include <cppast/visitor.hpp>
 
 #include "../../standardese/transformation/group_uncommented_transformation.hpp"
 #include "../../standardese/model/visitor/visit.hpp"
+#include "../../standardese/model/flat_document.hpp"
 #include "../../standardese/logger.hpp"
 
 namespace standardese::transformation {
@@ -124,7 +126,7 @@ void group_uncommented_transformation::do_transform(model::entity& document) {
 
       empty.pop();
       empty.top() &= is_empty;
-    }, document);
+    }, std::as_const(document));
   }
 
   // The explicitly or implicitly assigned group for the entities documented in
@@ -141,79 +143,80 @@ void group_uncommented_transformation::do_transform(model::entity& document) {
 
     }
     recurse();
-  }, document);
+  }, std::as_const(document));
 
   // Assign groups to uncommented entities.
-  model::visitor::visit([&](auto&& entity, auto&& recurse) {
-    using T = std::decay_t<decltype(entity)>;
+  const model::flat_document<> flat(document, false);
 
-    if constexpr (std::is_same_v<T, model::cpp_entity_documentation>) {
-      if (uncommented.at(&entity.entity()) && !entity.group.has_value() && groups(entity.entity().kind())) {
-        logger::trace([&]() { return fmt::format("Searching group for uncommented entity {}.", entity.entity().name()); });
-
-        // Search backwards in the C++ source code for a group entity.
-        const auto parent = entity.entity().parent();
-
-        const cppast::cpp_entity* previous = nullptr;
-
-        if (parent.has_value()) {
-          cppast::visit(parent.value(), [&](const cppast::cpp_entity& sibling, const cppast::visitor_info& info) {
-            if (&sibling == &parent.value())
-              // Enter the parent node and abort when leaving it.
-              return true;
-
-            if (&sibling == &entity.entity()) {
-              // previous is the node preceding our entity, copy its group if it has any.
-              if (previous != nullptr) {
-                if (group.find(previous) != group.end()) {
-                  logger::debug([&]() { return fmt::format("Adding {} to group {}.", entity.entity().name(), group.at(previous)); });
-                  entity.group = group.at(previous);
-                  group[&entity.entity()] = group.at(previous);
-                }
-              }
+  for (model::flat_document<>::index node = 0; node < flat.size(); node++) {
+    if (flat.kind(node) != model::node_kind::cpp_entity_documentation)
+      continue;
+
+    const auto& entity = flat.get<model::cpp_entity_documentation>(node);
+
+    if (uncommented.at(&entity.entity()) && !entity.group.has_value() && groups(entity.entity().kind())) {
+      logger::trace([&]() { return fmt::format("Searching group for uncommented entity {}.", entity.entity().name()); });
+
+      // Search backwards in the C++ source code for a group entity.
+      const auto parent = entity.entity().parent();
+
+      const cppast::cpp_entity* previous = nullptr;
 
-              // Abort the search.
-              return false;
+      if (parent.has_value()) {
+        cppast::visit(parent.value(), [&](const cppast::cpp_entity& sibling, const cppast::visitor_info& info) {
+          if (&sibling == &parent.value())
+            // Enter the parent node and abort when leaving it.
+            return true;
+
+          if (&sibling == &entity.entity()) {
+            // previous is the node preceding our entity, copy its group if it has any.
+            if (previous != nullptr) {
+              if (group.find(previous) != group.end()) {
+                logger::debug([&]() { return fmt::format("Adding {} to group {}.", entity.entity().name(), group.at(previous)); });
+                flat.as<model::cpp_entity_documentation>(node).group = group.at(previous);
+                group[&entity.entity()] = group.at(previous);
+              }
             }
 
-            switch (info.event) {
-              case cppast::visitor_info::container_entity_enter:
-              case cppast::visitor_info::leaf_entity:
-                if (!groups(sibling.kind())) {
-                  // This entity kind breaks the implicit grouping.
-                  previous = nullptr;
+            // Abort the search.
+            return false;
+          }
+
+          switch (info.event) {
+            case cppast::visitor_info::container_entity_enter:
+            case cppast::visitor_info::leaf_entity:
+              if (!groups(sibling.kind())) {
+                // This entity kind breaks the implicit grouping.
+                previous = nullptr;
+              } else {
+                if (uncommented.find(&sibling) == uncommented.end()) {
+                  // This entity is not present in this document.
+                  previous = nullptr; 
                 } else {
-                  if (uncommented.find(&sibling) == uncommented.end()) {
-                    // This entity is not present in this document.
-                    previous = nullptr; 
+                  if (uncommented.at(&sibling)) {
+                    // This entity is uncommented. Ignore its group.
                   } else {
-                    if (uncommented.at(&sibling)) {
-                      // This entity is uncommented. Ignore its group.
-                    } else {
-                      previous = &sibling;
-                    }
+                    previous = &sibling;
                   }
                 }
-                break;
-              case cppast::visitor_info::container_entity_exit:
-                break;
-            }
-
-            switch (info.event) {
-              case cppast::visitor_info::container_entity_enter:
-                  // Ignore the children of this container.
-                  return false;
-              default:
-                  // Continue the search.
-                  return true;
-            }
-          });
-        }
+              }
+              break;
+            case cppast::visitor_info::container_entity_exit:
+              break;
+          }
+
+          switch (info.event) {
+            case cppast::visitor_info::container_entity_enter:
+                // Ignore the children of this container.
+                return false;
+            default:
+                // Continue the search.
+                return true;
+          }
+        });
       }
     }
-
-    recurse();
-  }, document);
+  }
 }
 
 }
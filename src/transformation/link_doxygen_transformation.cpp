@@ -0,0 +1,52 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "../../standardese/transformation/link_doxygen_transformation.hpp"
+#include "../../standardese/model/flat_document.hpp"
+#include "../../standardese/model/markup/link.hpp"
+#include "../../standardese/model/entity.hpp"
+
+namespace standardese::transformation {
+
+link_doxygen_transformation::link_doxygen_transformation(model::unordered_entities& documents, struct options options, inventory::doxygen::tagfile_index inventory) : link_doxygen_transformation(documents, std::move(options), std::make_shared<const inventory::doxygen::tagfile_index>(std::move(inventory))) {}
+
+link_doxygen_transformation::link_doxygen_transformation(model::unordered_entities& documents, struct options options, std::shared_ptr<const inventory::doxygen::tagfile_index> inventory) : link_doxygen_transformation(documents, std::move(options), std::shared_ptr<const inventory::inventory>(std::move(inventory))) {}
+
+link_doxygen_transformation::link_doxygen_transformation(model::unordered_entities& documents, struct options options, inventory::doxygen::mapped_tagfile_index inventory) : link_doxygen_transformation(documents, std::move(options), std::make_shared<const inventory::doxygen::mapped_tagfile_index>(std::move(inventory))) {}
+
+link_doxygen_transformation::link_doxygen_transformation(model::unordered_entities& documents, struct options options, std::shared_ptr<const inventory::inventory> inventory) : transformation(documents), options(std::move(options)), inventory(std::move(inventory)), target_transformation(documents, inventory::symbols(*this->inventory)) {}
+
+void link_doxygen_transformation::transform(model::entity& document) {
+  target_transformation.transform(document);
+  transformation::transform(document);
+}
+
+void link_doxygen_transformation::do_transform(model::entity& document) {
+  const model::flat_document<> flat(document, false);
+
+  for (model::flat_document<>::index node = 0; node < flat.size(); node++) {
+    if (flat.kind(node) != model::node_kind::link)
+      continue;
+
+    flat.get<model::markup::link>(node).target.accept([&](auto&& target) {
+      using T = std::decay_t<decltype(target)>;
+      if constexpr (std::is_same_v<T, model::link_target::doxygen_target>) {
+        if (&*target.inventory == inventory.get()) {
+          auto uri = options.url + target.filename;
+
+          // Some versions of doxygen omit the extension of HTML pages.
+          if (target.filename.find('.', target.filename.rfind('/') + 1) == std::string::npos)
+            uri += ".html";
+
+          if (!target.anchor.empty())
+            uri += "#" + target.anchor;
+
+          flat.as<model::markup::link>(node).target = model::link_target::uri_target(uri);
+        }
+      }
+    });
+  }
+}
+
+}
@@ -5,7 +5,7 @@
 #include <regex>
 
 #include "../../standardese/transformation/link_external_legacy_transformation.hpp"
-#include "../../standardese/model/visitor/visit.hpp"
+#include "../../standardese/model/flat_document.hpp"
 #include "../../standardese/model/markup/link.hpp"
 #include "../../standardese/model/entity.hpp"
 #include "../../standardese/logger.hpp"
@@ -15,25 +15,25 @@ namespace standardese::transformation {
 link_external_legacy_transformation::link_external_legacy_transformation(model::unordered_entities& documents, struct options options): transformation(documents), options(options) {}
 
 void link_external_legacy_transformation::do_transform(model::entity& document) {
-  model::visitor::visit([&](auto&& link, auto&& recurse) {
-    using T = std::decay_t<decltype(link)>;
-    if constexpr (std::is_same_v<T, model::markup::link>) {
-      link.target.accept([&](auto&& target) {
-        using T = std::decay_t<decltype(target)>;
-        if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
-          const static std::regex pattern{R"((?:::)?(([^:]*)::.*))"};
-
-          std::smatch match;
-          if (std::regex_match(target.target, match, pattern) && match.str(2) == options.namspace) {
-            const static std::regex replace{R"(\$\$)"};
-            link.target = model::link_target::uri_target(std::regex_replace(options.url, replace, match.str(1)));
-          }
-        }
-      });
-    }
+  const model::flat_document<> flat(document, false);
+
+  for (model::flat_document<>::index node = 0; node < flat.size(); node++) {
+    if (flat.kind(node) != model::node_kind::link)
+      continue;
 
-    recurse();
-  }, document);
+    flat.get<model::markup::link>(node).target.accept([&](auto&& target) {
+      using T = std::decay_t<decltype(target)>;
+      if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
+        const static std::regex pattern{R"((?:::)?(([^:]*)::.*))"};
+
+        std::smatch match;
+        if (std::regex_match(target.target.str(), match, pattern) && match.str(2) == options.namspace) {
+          const static std::regex replace{R"(\$\$)"};
+          flat.as<model::markup::link>(node).target = model::link_target::uri_target(std::regex_replace(options.url, replace, match.str(1)));
+        }
+      }
+    });
+  }
 }
 
 }
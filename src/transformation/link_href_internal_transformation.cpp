@@ -8,7 +8,7 @@
 #include <cstdlib>
 
 #include "../../standardese/transformation/link_href_internal_transformation.hpp"
-#include "../../standardese/model/visitor/visit.hpp"
+#include "../../standardese/model/flat_document.hpp"
 #include "../../standardese/model/markup/link.hpp"
 #include "../../standardese/model/cpp_entity_documentation.hpp"
 #include "../../standardese/model/group_documentation.hpp"
@@ -23,60 +23,65 @@ link_href_internal_transformation::link_href_internal_transformation(model::unor
   transformation(documents),
   anchors([&]() {
     std::string path;
-    std::unordered_map<const cppast::cpp_entity*, std::string> a;
-
-    for (const auto& document : documents)
-      model::visitor::visit([&](auto&& entity, auto&& recurse) {
-        using T = std::decay_t<decltype(entity)>;
-
-        if constexpr (std::is_same_v<T, model::document>) {
-          path = entity.path;
-        } else if constexpr (std::is_same_v<T, model::cpp_entity_documentation>) {
-          a[&entity.entity()] = path + "#" + entity.id;
-        } else if constexpr (std::is_same_v<T, model::group_documentation>) {
-          for (const auto& member : entity.entities) {
-            a[&member.entity()] = path + "#" + entity.id;
+    std::unordered_map<const cppast::cpp_entity*, model::interned_string> a;
+
+    for (const auto& document : documents) {
+      const model::flat_document<true> flat(document, false);
+
+      for (model::flat_document<true>::index node = 0; node < flat.size(); node++) {
+        switch (flat.kind(node)) {
+          case model::node_kind::document:
+            path = "/" + flat.as<model::document>(node).path.str() + "#";
+            break;
+          case model::node_kind::cpp_entity_documentation: {
+            const auto& entity = flat.as<model::cpp_entity_documentation>(node);
+            a[&entity.entity()] = path + entity.id.str();
+            break;
+          }
+          case model::node_kind::group_documentation: {
+            const auto& entity = flat.as<model::group_documentation>(node);
+            const model::interned_string href = path + entity.id.str();
+            for (const auto& member : entity.entities) {
+              a[&member.entity()] = href;
+            }
+            break;
           }
+          default:
+            break;
         }
-
-        recurse();
-      }, document);
+      }
+    }
 
     return a;
   }()) {
 }
 
 void link_href_internal_transformation::do_transform(model::entity& document) {
-  struct visitor : model::visitor::recursive_visitor<false> {
-    visitor(const std::unordered_map<const cppast::cpp_entity*, std::string>& inventory) : inventory(inventory) {}
-
-    void visit(link& link) override {
-      link.target.accept([&](auto&& target) -> void {
-        using T = std::decay_t<decltype(target)>;
-        if constexpr (std::is_same_v<T, model::link_target::module_target>) {
-          throw std::logic_error("not implemented: resolve_module_target");
-        } else if constexpr (std::is_same_v<T, model::link_target::cppast_target>) {
-          // TODO: Use cppast ids instead?
-          auto resolved = inventory.find(&*target.target);
-          if (resolved == inventory.end()) {
-              // TODO: Write a proper name for target.
-              // TODO: Include kind in message.
-              logger::error(fmt::format("Could not create URL for link to `{}`. Target was not found in inventory of C++ entities which are linkable.", target.target->name()));
-              return;
-          }
-
-          // TODO: Make relative
-          link.target = model::link_target::uri_target("/" + resolved->second);
+  const model::flat_document<> flat(document, false);
+
+  for (model::flat_document<>::index node = 0; node < flat.size(); node++) {
+    if (flat.kind(node) != model::node_kind::link)
+      continue;
+
+    flat.get<model::markup::link>(node).target.accept([&](auto&& target) -> void {
+      using T = std::decay_t<decltype(target)>;
+      if constexpr (std::is_same_v<T, model::link_target::module_target>) {
+        throw std::logic_error("not implemented: resolve_module_target");
+      } else if constexpr (std::is_same_v<T, model::link_target::cppast_target>) {
+        // TODO: Use cppast ids instead?
+        auto resolved = anchors.find(&*target.target);
+        if (resolved == anchors.end()) {
+            // TODO: Write a proper name for target.
+            // TODO: Include kind in message.
+            logger::error(fmt::format("Could not create URL for link to `{}`. Target was not found in inventory of C++ entities which are linkable.", target.target->name()));
+            return;
         }
-      });
-
-      model::visitor::recursive_visitor<false>::visit(link);
-    }
-
-    const std::unordered_map<const cppast::cpp_entity*, std::string>& inventory;
-  } visitor(anchors);
 
-  document.accept(visitor);
+        // TODO: Make relative
+        flat.as<model::markup::link>(node).target = model::link_target::uri_target(resolved->second);
+      }
+    });
+  }
 }
 
 }
@@ -3,34 +3,40 @@
 // found in the top-level directory of this distribution.
 
 #include "../../standardese/transformation/link_sphinx_transformation.hpp"
-#include "../../standardese/model/visitor/visit.hpp"
+#include "../../standardese/model/flat_document.hpp"
 #include "../../standardese/model/markup/link.hpp"
 #include "../../standardese/model/entity.hpp"
 
 namespace standardese::transformation {
 
-link_sphinx_transformation::link_sphinx_transformation(model::unordered_entities& documents, struct options options, inventory::sphinx::documentation_set inventory) : transformation(documents), options(std::move(options)), inventory(std::move(inventory)), target_transformation(documents, inventory::symbols(this->inventory)) {}
+link_sphinx_transformation::link_sphinx_transformation(model::unordered_entities& documents, struct options options, inventory::sphinx::documentation_set inventory) : link_sphinx_transformation(documents, std::move(options), std::make_shared<const inventory::sphinx::documentation_set>(std::move(inventory))) {}
 
-void link_sphinx_transformation::transform(threading::pool::factory workers) {
-  target_transformation.transform(workers);
-  transformation::transform(workers);
+link_sphinx_transformation::link_sphinx_transformation(model::unordered_entities& documents, struct options options, std::shared_ptr<const inventory::sphinx::documentation_set> inventory) : link_sphinx_transformation(documents, std::move(options), inventory, inventory->project, inventory->version) {}
+
+link_sphinx_transformation::link_sphinx_transformation(model::unordered_entities& documents, struct options options, inventory::sphinx::mapped_documentation_set inventory) : link_sphinx_transformation(documents, std::move(options), std::make_shared<const inventory::sphinx::mapped_documentation_set>(inventory), std::string(inventory.project()), std::string(inventory.version())) {}
+
+link_sphinx_transformation::link_sphinx_transformation(model::unordered_entities& documents, struct options options, std::shared_ptr<const inventory::inventory> inventory, std::string project, std::string version) : transformation(documents), options(std::move(options)), inventory(std::move(inventory)), project(std::move(project)), version(std::move(version)), target_transformation(documents, inventory::symbols(*this->inventory)) {}
+
+void link_sphinx_transformation::transform(model::entity& document) {
+  target_transformation.transform(document);
+  transformation::transform(document);
 }
 
 void link_sphinx_transformation::do_transform(model::entity& document) {
-  model::visitor::visit([&](auto&& link, auto&& recurse) {
-    using T = std::decay_t<decltype(link)>;
-    if constexpr (std::is_same_v<T, model::markup::link>) {
-      link.target.accept([&](auto&& target) {
-        using T = std::decay_t<decltype(target)>;
-        if constexpr (std::is_same_v<T, model::link_target::sphinx_target>) {
-          if (target.project == inventory.project && target.version == inventory.version)
-            link.target = model::link_target::uri_target(options.url + target.entry.uri);
-        }
-      });
-    }
-
-    recurse();
-  }, document);
+  const model::flat_document<> flat(document, false);
+
+  for (model::flat_document<>::index node = 0; node < flat.size(); node++) {
+    if (flat.kind(node) != model::node_kind::link)
+      continue;
+
+    flat.get<model::markup::link>(node).target.accept([&](auto&& target) {
+      using T = std::decay_t<decltype(target)>;
+      if constexpr (std::is_same_v<T, model::link_target::sphinx_target>) {
+        if (target.project == project && target.version == version)
+          flat.as<model::markup::link>(node).target = model::link_target::uri_target(options.url + target.entry.uri);
+      }
+    });
+  }
 }
 
 }
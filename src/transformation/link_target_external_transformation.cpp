@@ -5,40 +5,53 @@
 #include <fmt/format.h>
 #include <regex>
 #include <cstdlib>
+#include <vector>
 
 #include <cppast/cpp_file.hpp>
 
 #include "../../standardese/transformation/link_target_external_transformation.hpp"
-#include "../../standardese/model/visitor/visit.hpp"
+#include "../../standardese/model/flat_document.hpp"
 #include "../../standardese/model/markup/link.hpp"
 #include "../../standardese/model/entity.hpp"
+#include "../../standardese/stats.hpp"
 
 namespace standardese::transformation
 {
 
 link_target_external_transformation::link_target_external_transformation(model::unordered_entities& documents, inventory::symbols symbols) :
   transformation(documents),
-  symbols(std::move(symbols)) {}
+  symbols(std::move(symbols)) {
+  stats::memory("link inventory: external symbols", this->symbols.memory());
+}
 
 void link_target_external_transformation::do_transform(model::entity& document) {
-  model::visitor::visit([&](auto&& link, auto&& recurse) {
-    using T = std::decay_t<decltype(link)>;
-    if constexpr (std::is_same_v<T, model::markup::link>) {
-      link.target.accept([&](auto&& target) {
-        using T = std::decay_t<decltype(target)>;
-        if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
-          // TODO: Support relative lookup here.
-          auto search = symbols.find(target.target);
-          if (search)
-            link.target = search.value();
-        }
-
-        // TODO: Handle the special schema:// here.
-      });
-    }
-
-    recurse();
-  }, document);
+  const model::flat_document<> flat(document, false);
+
+  // The unresolved links of this document which we look up all at once.
+  std::vector<model::flat_document<>::index> links;
+  std::vector<inventory::symbols::lookup> lookups;
+
+  for (model::flat_document<>::index node = 0; node < flat.size(); node++) {
+    if (flat.kind(node) != model::node_kind::link)
+      continue;
+
+    flat.get<model::markup::link>(node).target.accept([&](auto&& target) {
+      using T = std::decay_t<decltype(target)>;
+      if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
+        // TODO: Support relative lookup here.
+        links.push_back(node);
+        lookups.emplace_back(target.target);
+      }
+
+      // TODO: Handle the special schema:// here.
+    });
+  }
+
+  symbols.find(lookups);
+
+  for (std::size_t i = 0; i < links.size(); i++)
+    if (lookups[i].target)
+      flat.as<model::markup::link>(links[i]).target = std::move(lookups[i].target.value());
 }
 
 }
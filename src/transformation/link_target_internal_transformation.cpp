@@ -4,118 +4,134 @@
 // found in the top-level directory of this distribution.
 
 #include <fmt/format.h>
-#include <regex>
-#include <cstdlib>
+#include <string_view>
+#include <vector>
 
 #include <cppast/cpp_file.hpp>
 
 #include "../../standardese/transformation/link_target_internal_transformation.hpp"
 #include "../../standardese/model/visitor/visit.hpp"
+#include "../../standardese/model/flat_document.hpp"
 #include "../../standardese/model/markup/link.hpp"
 #include "../../standardese/model/cpp_entity_documentation.hpp"
 #include "../../standardese/model/unordered_entities.hpp"
 #include "../../standardese/inventory/symbols.hpp"
 #include "../../standardese/logger.hpp"
+#include "../../standardese/stats.hpp"
 
 namespace standardese::transformation {
 
+namespace {
+
+/// Return the C++ entities and the C++ header files that are documented in
+/// the `documents`.
+std::pair<std::vector<const cppast::cpp_entity*>, std::vector<const cppast::cpp_file*>> documented(const model::unordered_entities& documents) {
+  stats::timer timer{"link inventory: collect documented entities"};
+
+  std::vector<const cppast::cpp_entity*> entities;
+  std::vector<const cppast::cpp_file*> headers;
+
+  for (const auto& document : documents) {
+    model::visitor::visit([&](auto&& entity, auto&& recurse) {
+      using T = std::decay_t<decltype(entity)>;
+      if constexpr (std::is_base_of_v<model::cpp_entity_documentation, T>) {
+        entities.push_back(&entity.entity());
+        if (entity.entity().kind() == cppast::cpp_file::kind())
+          headers.push_back(static_cast<const cppast::cpp_file*>(&entity.entity()));
+      }
+      recurse();
+    }, document);
+  }
+
+  stats::count("link inventory: documented entities", entities.size());
+  stats::count("link inventory: documented headers", headers.size());
+
+  return {std::move(entities), std::move(headers)};
+}
+
+}
+
 link_target_internal_transformation::link_target_internal_transformation(model::unordered_entities& documents, const parser::cpp_context& context) :
+  link_target_internal_transformation(documents, context, documented(documents)) {}
+
+link_target_internal_transformation::link_target_internal_transformation(model::unordered_entities& documents, const parser::cpp_context& context, std::pair<std::vector<const cppast::cpp_entity*>, std::vector<const cppast::cpp_file*>> documented) :
   transformation(documents),
-  inventory([&]() {
-    // Create an inventory of all the C++ entities that are documented in all the documents.
-    std::vector<const cppast::cpp_entity*> entities;
-
-    for (const auto& document : documents) {
-      model::visitor::visit([&](auto&& entity, auto&& recurse) {
-        using T = std::decay_t<decltype(entity)>;
-        if constexpr (std::is_base_of_v<model::cpp_entity_documentation, T>)
-          entities.push_back(&entity.entity());
-        recurse();
-      }, document);
-    }
-
-    return entities;
-  }(), context),
-  files([&]() {
-    // Create an inventory of all the C++ headers files that are explicitly documented.
-    std::vector<const cppast::cpp_file*> headers;
-
-    for (const auto& document : documents) {
-      model::visitor::visit([&](auto&& entity, auto&& recurse) {
-        using T = std::decay_t<decltype(entity)>;
-        if constexpr (std::is_base_of_v<model::cpp_entity_documentation, T>) {
-          if (entity.entity().kind() == cppast::cpp_file::kind())
-            headers.push_back(static_cast<const cppast::cpp_file*>(&entity.entity()));
-        }
-        recurse();
-      }, document);
-    }
+  // Create an inventory of all the C++ entities that are documented in all the documents.
+  inventory(documented.first, context),
+  // Create an inventory of all the C++ headers files that are explicitly documented.
+  files(documented.second),
+  symbols(inventory) {
+}
 
-    return headers;
-  }()) {
+link_target_internal_transformation::~link_target_internal_transformation() {
+  // The symbols only index what has been looked up, so we can only tell how
+  // much memory they need once all documents have been transformed.
+  stats::memory("link inventory: internal symbols", symbols.memory());
 }
 
-void link_target_internal_transformation::do_transform(model::entity& document) {
-  inventory::symbols symbols{inventory};
-  std::stack<type_safe::object_ref<const cppast::cpp_entity>> relative;
+bool link_target_internal_transformation::is_uri(std::string_view target) {
+  const auto scheme = target.find_first_of(":/?#");
+  if (scheme == 0 || scheme == std::string_view::npos || target.compare(scheme, 3, "://") != 0)
+    return false;
 
-  model::visitor::visit([&](auto& link, auto&& recurse) {
-    using T = std::decay_t<decltype(link)>;
-    if constexpr (std::is_same_v<T, model::cpp_entity_documentation>) {
-      relative.push(type_safe::ref(link.entity()));
-      recurse();
-      relative.pop();
-      return;
-    }
-
-    if constexpr (std::is_same_v<T, model::markup::link>) {
-      link.target.accept([&](auto&& target) {
-        using T = std::decay_t<decltype(target)>;
-        if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
-          if (target.target == "") return;
-
-          {
-            // TODO: This is a hack, see heading transformation.
-            const static std::regex entity_pattern{"^standardese://@([0-9]*)$"};
-            std::smatch match;
-            if (std::regex_match(target.target, match, entity_pattern)) {
-              link.target = model::link_target(*static_cast<const cppast::cpp_entity*>((void*)atol(match[1].str().c_str())));
-              return;
-            }
-          }
+  // The fragment cannot contain line breaks.
+  const auto fragment = target.find('#', scheme);
+  return fragment == std::string_view::npos || target.find_first_of("\r\n", fragment) == std::string_view::npos;
+}
 
-          // TODO: Perform relative lookup.
-          {
-            const auto entity = files.find_header(target.target);
-            if (entity) {
-              link.target = model::link_target(std::move(entity.value()));
-              return;
-            }
-          }
+void link_target_internal_transformation::do_transform(model::entity& document) {
+  using model::flat_document;
+
+  // We only need the structure of the document but not its text.
+  const flat_document<> flat(document, false);
+
+  // The links that might refer to C++ entities. We look them all up at once
+  // once we have seen the entire document.
+  std::vector<flat_document<>::index> links;
+  std::vector<inventory::symbols::lookup> lookups;
+
+  for (flat_document<>::index node = 0; node < flat.size(); node++) {
+    if (flat.kind(node) != model::node_kind::link)
+      continue;
+
+    // Links are resolved relative to the C++ entity they are documenting.
+    type_safe::optional_ref<const cppast::cpp_entity> relative;
+    if (const auto scope = flat.ancestor(node, model::node_kind::cpp_entity_documentation); scope != flat_document<>::none)
+      relative = type_safe::opt_cref(&flat.get<model::cpp_entity_documentation>(scope).entity());
+
+    const auto& link = flat.get<model::markup::link>(node);
+    link.target.accept([&](auto&& target) {
+      using T = std::decay_t<decltype(target)>;
+      if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
+        if (target.target == "") return;
+
+        if (is_uri(target.target.str())) {
+          // TODO: Handle standardese:// schemes here.
+          return;
+        }
 
-          // Taken from RFC3986 p.50. Adapted so that scheme & authority are not optional.
-          const static std::regex uri_pattern{R"(^(([^:/?#]+):)(//([^/?#]*))([^?#]*)(\?([^#]*))?(#(.*))?)"};
-          std::smatch match;
-          if (std::regex_match(target.target, match, uri_pattern)) {
-            // TODO: Handle standardese:// schemes here.
+        {
+          const auto entity = relative ?
+            files.find_header(target.target, relative.value()) :
+            files.find_header(target.target);
+          if (entity) {
+            flat.as<model::markup::link>(node).target = model::link_target(std::move(entity.value()));
             return;
           }
+        }
 
-          // TODO: Handle \unique_name
-          {
-            auto entity = relative.size() ?
-              symbols.find(target.target, *relative.top()) :
-              symbols.find(target.target);
+        // TODO: Handle \unique_name
+        links.push_back(node);
+        lookups.emplace_back(target.target, relative);
+      }
+    });
+  }
 
-            if (entity.has_value())
-              link.target = std::move(entity.value());
-          }
-        }
-      });
-    }
+  symbols.find(lookups);
 
-    recurse();
-  }, document);
+  for (std::size_t i = 0; i < links.size(); i++)
+    if (lookups[i].target)
+      flat.as<model::markup::link>(links[i]).target = std::move(lookups[i].target.value());
 }
 
 }
@@ -10,33 +10,40 @@
 #include <cppast/cpp_file.hpp>
 
 #include "../../standardese/transformation/link_target_unresolved_transformation.hpp"
-#include "../../standardese/model/visitor/visit.hpp"
+#include "../../standardese/model/flat_document.hpp"
 #include "../../standardese/model/markup/link.hpp"
 #include "../../standardese/logger.hpp"
 
 namespace standardese::transformation {
 
-link_target_unresolved_transformation::link_target_unresolved_transformation(model::unordered_entities& documents) : transformation(documents) {}
+link_target_unresolved_transformation::link_target_unresolved_transformation(model::unordered_entities& documents) : link_target_unresolved_transformation(documents, {}) {}
+
+link_target_unresolved_transformation::link_target_unresolved_transformation(model::unordered_entities& documents, struct options options) : transformation(documents), options(std::move(options)) {}
 
 void link_target_unresolved_transformation::do_transform(model::entity& document) {
-  model::visitor::visit([](auto&& link, auto&& recurse) {
-    using T = std::decay_t<decltype(link)>;
-    if constexpr (std::is_same_v<T, model::markup::link>) {
-      link.target.accept([&](auto&& target) {
-        using T = std::decay_t<decltype(target)>;
-        if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
-          if (target.target == "") {
-            link.target = model::link_target::uri_target("");
-            return;
-          }
-
-          standardese::logger::warn(fmt::format("Could not resolve link target `{}`.", target.target));
+  const model::flat_document<> flat(document, false);
+
+  for (model::flat_document<>::index node = 0; node < flat.size(); node++) {
+    if (flat.kind(node) != model::node_kind::link)
+      continue;
+
+    flat.get<model::markup::link>(node).target.accept([&](auto&& target) {
+      using T = std::decay_t<decltype(target)>;
+      if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
+        if (target.target == "") {
+          flat.as<model::markup::link>(node).target = model::link_target::uri_target("");
+          return;
+        }
+
+        if (!options.defer.empty()) {
+          flat.as<model::markup::link>(node).target = model::link_target::uri_target(options.defer + target.target.str());
+          return;
         }
-      });
-    }
 
-    recurse();
-  }, document);
+        standardese::logger::warn(fmt::format("Could not resolve link target `{}`.", target.target.str()));
+      }
+    });
+  }
 }
 
 }
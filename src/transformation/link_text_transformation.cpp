@@ -7,7 +7,7 @@
 #include <nlohmann/json.hpp>
 
 #include "../../standardese/transformation/link_text_transformation.hpp"
-#include "../../standardese/model/visitor/visit.hpp"
+#include "../../standardese/model/flat_document.hpp"
 #include "../../standardese/formatter/inja_formatter.hpp"
 #include "../../standardese/model/link_target.hpp"
 #include "../../standardese/logger.hpp"
@@ -18,58 +18,61 @@ template<class> inline constexpr bool always_false_v = false;
 namespace standardese::transformation {
 
 void link_text_transformation::do_transform(model::entity& root) {
-  model::visitor::visit([&](auto& link, auto&& recurse) {
-    using T = std::decay_t<decltype(link)>;
+  const model::flat_document<> flat(root, false);
 
-    if constexpr (std::is_same_v<T, model::markup::link>) {
-      if (link.begin() == link.end()) {
-        link.target.accept([&](auto&& target) {
-          using T = std::decay_t<decltype(target)>;
+  for (model::flat_document<>::index node = 0; node < flat.size(); node++) {
+    if (flat.kind(node) != model::node_kind::link)
+      continue;
 
-          const auto apply = [&](const std::string& format, auto&& data) {
-            formatter::inja_formatter inja({});
-            inja.data().merge_patch(inja.to_json(data));
+    const auto& link = flat.get<model::markup::link>(node);
+    if (link.begin() == link.end()) {
+      link.target.accept([&](auto&& target) {
+        using T = std::decay_t<decltype(target)>;
 
-            auto rendered = inja.build(format);
+        const auto apply = [&](const std::string& format, auto&& data) {
+          formatter::inja_formatter inja({});
+          inja.data().merge_patch(inja.to_json(data));
 
-            auto paragraph = rendered.begin();
+          auto rendered = inja.build(format);
 
-            if (paragraph == rendered.end()) {
-              // Format string produced an empty markup tree.
-              return;
-            }
+          auto paragraph = rendered.begin();
 
-            if (!paragraph->template is<model::markup::paragraph>()) {
-              logger::error(fmt::format("Expected anchor to render as a single paragraph but {} rendered as {} instead.", output_generator::xml::xml_generator::render(rendered), output_generator::xml::xml_generator::render(*paragraph)));
-              return;
-            }
+          if (paragraph == rendered.end()) {
+            // Format string produced an empty markup tree.
+            return;
+          }
 
-            for (auto& child : paragraph->template as<model::markup::paragraph>()) {
-              link.add_child(std::move(child));
-            }
-          };
+          if (!paragraph->template is<model::markup::paragraph>()) {
+            logger::error(fmt::format("Expected anchor to render as a single paragraph but {} rendered as {} instead.", output_generator::xml::xml_generator::render(rendered), output_generator::xml::xml_generator::render(*paragraph)));
+            return;
+          }
 
-          if constexpr (std::is_same_v<T, model::link_target::cppast_target>) {
-            apply(options.cppast_format, link.target);
-          } else if constexpr (std::is_same_v<T, model::link_target::module_target>) {
-            apply(options.module_format, link.target);
-          } else if constexpr (std::is_same_v<T, model::link_target::sphinx_target>) {
-            apply(options.sphinx_format, link.target);
-          } else if constexpr (std::is_same_v<T, model::link_target::doxygen_target>) {
-            apply(options.doxygen_format, link.target);
-          } else if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
-            apply(options.standardese_format, link.target);
-          } else if constexpr (std::is_same_v<T, model::link_target::uri_target>) {
-            apply(options.uri_format, link.target);
-          } else {
-            static_assert(always_false_v<T>, "unsupported link target type");
+          // The link has no children in the index, so adding children
+          // does not affect the nodes we have not visited yet.
+          auto& modified = flat.as<model::markup::link>(node);
+          for (auto& child : paragraph->template as<model::markup::paragraph>()) {
+            modified.add_child(std::move(child));
           }
-        });
-      }
-    }
+        };
 
-    recurse();
-  }, root);
+        if constexpr (std::is_same_v<T, model::link_target::cppast_target>) {
+          apply(options.cppast_format, link.target);
+        } else if constexpr (std::is_same_v<T, model::link_target::module_target>) {
+          apply(options.module_format, link.target);
+        } else if constexpr (std::is_same_v<T, model::link_target::sphinx_target>) {
+          apply(options.sphinx_format, link.target);
+        } else if constexpr (std::is_same_v<T, model::link_target::doxygen_target>) {
+          apply(options.doxygen_format, link.target);
+        } else if constexpr (std::is_same_v<T, model::link_target::standardese_target>) {
+          apply(options.standardese_format, link.target);
+        } else if constexpr (std::is_same_v<T, model::link_target::uri_target>) {
+          apply(options.uri_format, link.target);
+        } else {
+          static_assert(always_false_v<T>, "unsupported link target type");
+        }
+      });
+    }
+  }
 }
 
 }
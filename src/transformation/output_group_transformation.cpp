@@ -15,8 +15,7 @@
 namespace standardese::transformation {
 
 void output_group_transformation::do_transform(model::entity& document) {
-  std::stack<std::vector<model::entity>> containers;
-  containers.push({});
+  model::visitor::rebuilt_containers containers;
 
   std::stack<bool> has_output_section;
 
@@ -41,7 +40,7 @@ void output_group_transformation::do_transform(model::entity& document) {
           heading.add_child(std::move(child));
         }
 
-        containers.top().emplace_back(heading);
+        containers.top().emplace_back(std::move(heading));
         has_output_section.top() = true;
       }
     }
@@ -54,7 +53,7 @@ void output_group_transformation::do_transform(model::entity& document) {
     }
 
     if constexpr (std::is_base_of_v<model::mixin::container<>, T>) {
-      containers.push({});
+      containers.enter();
       has_output_section.push(false);
       level.push(level.top());
 
@@ -65,13 +64,10 @@ void output_group_transformation::do_transform(model::entity& document) {
       level.pop();
       has_output_section.pop();
 
-      entity.clear();
-      for (auto& child : containers.top()) entity.emplace_child(std::move(child));
-
-      containers.pop();
+      containers.leave(entity);
     }
 
-    containers.top().emplace_back(entity);
+    containers.keep(std::move(entity));
   }, document);
 }
 
@@ -0,0 +1,45 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "../../standardese/transformation/pipeline.hpp"
+#include "../../standardese/model/unordered_entities.hpp"
+#include "../../standardese/threading/for_each.hpp"
+#include "../../standardese/logger.hpp"
+
+namespace standardese::transformation {
+
+pipeline::pipeline(model::unordered_entities& documents) : documents(documents) {}
+
+void pipeline::add(dependency dependency, std::function<std::unique_ptr<transformation>(model::unordered_entities&)> create) {
+  if (stages.empty() || dependency == pipeline::dependency::all_documents)
+    stages.emplace_back();
+
+  stages.back().emplace_back(std::move(create));
+}
+
+void pipeline::transform(threading::pool& workers) {
+  for (const auto& stage : stages) {
+    // Create the transformations of this stage. Their constructors might
+    // inspect all the documents, so this must happen before any document
+    // enters the stage.
+    std::vector<std::unique_ptr<transformation>> transformations;
+    for (const auto& create : stage)
+      transformations.emplace_back(create(documents));
+
+    // Run each document through the stage independently.
+    threading::for_each(workers, documents.begin(), documents.end(), [&](model::entity& document) {
+      for (auto& transformation : transformations) {
+        // A failing transformation should not keep the later ones from
+        // running on this document.
+        try {
+          transformation->transform(document);
+        } catch (std::exception& e) {
+          logger::error(e.what());
+        }
+      }
+    }, 1);
+  }
+}
+
+}
@@ -11,9 +11,17 @@ namespace standardese::transformation {
 transformation::transformation(model::unordered_entities& entities) : entities(entities) {}
 
 void transformation::transform(threading::pool::factory workers) {
+  transform(*workers());
+}
+
+void transformation::transform(threading::pool& workers) {
   threading::for_each(workers, entities.begin(), entities.end(), [this](auto& e) {
-    do_transform(e);
-  });
+    transform(e);
+  }, 1);
+}
+
+void transformation::transform(model::entity& root) {
+  do_transform(root);
 }
 
 }
@@ -57,6 +57,10 @@ class module;
 class unordered_entities;
 class section;
 class link_target;
+class interned_string;
+enum class node_kind : unsigned char;
+template <bool>
+class flat_document;
 
 }
 
@@ -106,9 +110,16 @@ class cppast_inventory;
 class symbols;
 }
 
+namespace standardese::inventory::doxygen {
+struct tagfile;
+class tagfile_index;
+class mapped_tagfile_index;
+}
+
 namespace standardese::inventory::sphinx {
 class entry;
 class documentation_set;
+class mapped_documentation_set;
 }
 
 namespace standardese::parser::commands
@@ -133,6 +144,7 @@ class link_target_internal_transformation;
 class link_target_external_transformation;
 class link_href_internal_transformation;
 class link_sphinx_transformation;
+class link_doxygen_transformation;
 class link_external_legacy_transformation;
 class anchor_transformation;
 class exclude_pattern_transformation;
@@ -7,6 +7,12 @@
 
 #include <cppast/forward.hpp>
 #include <type_safe/optional_ref.hpp>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "../parser/cpp_context.hpp"
@@ -36,6 +42,35 @@ class cppast_inventory : public inventory {
 
     std::unordered_set<const cppast::cpp_file*> roots;
     const parser::cpp_context context;
+
+    /// The members of scopes indexed by all the names under which
+    /// [symbols]() finds them.
+    /// A scope is indexed the first time a name is looked up in it so that
+    /// repeated lookups do not need to walk the AST again. Copies of this
+    /// inventory share the index.
+    struct index {
+      /// Reports the hits and misses of the lookup cache to [stats]().
+      ~index();
+
+      std::shared_mutex mutex;
+      std::unordered_map<const cppast::cpp_entity*, std::unordered_map<std::string, const cppast::cpp_entity*>> members;
+
+      /// The results of relative lookups by the scope they started from and
+      /// the name that was looked up, including lookups that found nothing.
+      /// The cache is split into shards that are locked separately so that
+      /// parallel lookups rarely wait for each other.
+      struct shard {
+        std::shared_mutex mutex;
+        std::unordered_map<const cppast::cpp_entity*, std::unordered_map<std::string, const cppast::cpp_entity*>> lookups;
+      };
+
+      std::array<shard, 64> lookups;
+
+      std::atomic<std::size_t> hits = 0;
+      std::atomic<std::size_t> misses = 0;
+    };
+
+    std::shared_ptr<struct index> index = std::make_shared<struct index>();
 };
 
 }
@@ -0,0 +1,67 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_INVENTORY_DOXYGEN_MAPPED_TAGFILE_INDEX_HPP_INCLUDED
+#define STANDARDESE_INVENTORY_DOXYGEN_MAPPED_TAGFILE_INDEX_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <type_safe/optional.hpp>
+
+#include "tagfile_index.hpp"
+#include "../inventory.hpp"
+
+namespace standardese::inventory::doxygen {
+
+/// A [tagfile_index]() in a compact binary format that is memory mapped
+/// read-only from disk.
+///
+/// Indexing a tagfile means reading all of its XML. The binary format has
+/// the same layout as a [sphinx::mapped_documentation_set](), i.e., a table
+/// of all the strings and a hash index of the names, so it can be used
+/// without reading it into memory first.
+class mapped_tagfile_index : public inventory {
+ public:
+  /// Return the binary index at `path` if it has been written for a tagfile
+  /// whose contents have the `hash`.
+  static type_safe::optional<mapped_tagfile_index> open(const boost::filesystem::path& path, const std::string& hash);
+
+  /// Write `index` in the binary format to `path` and record that it has
+  /// been created from a tagfile whose contents have the `hash`.
+  static void write(const boost::filesystem::path& path, const tagfile_index& index, const std::string& hash);
+
+  /// Return the number of entities in this index.
+  std::size_t size() const;
+
+  /// Return the location of the entity with the fully qualified `name`.
+  /// The filename of the location points into the mapped file.
+  type_safe::optional<tagfile_index::location> find(std::string_view name) const;
+
+ private:
+  struct header;
+  struct string;
+  struct record;
+  struct slot;
+
+  explicit mapped_tagfile_index(boost::iostreams::mapped_file_source);
+
+  /// Return whether all the strings and records that this index refers to
+  /// are within the mapped file.
+  bool valid() const;
+
+  const header& head() const;
+  const record* records() const;
+  const slot* names() const;
+  std::string_view str(const string&) const;
+
+  boost::iostreams::mapped_file_source file;
+};
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_INVENTORY_DOXYGEN_TAGFILE_INDEX_HPP_INCLUDED
+#define STANDARDESE_INVENTORY_DOXYGEN_TAGFILE_INDEX_HPP_INCLUDED
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <type_safe/optional_ref.hpp>
+
+#include "../inventory.hpp"
+
+namespace standardese::inventory::doxygen {
+
+/// The locations of the C++ entities that are documented in a [tagfile]()
+/// by their fully qualified names.
+///
+/// The index is read directly from the XML of a tagfile, one compound at a
+/// time, and only keeps the names, pages, and anchors of classes, concepts,
+/// namespaces, files, and their members. Everything else in the tagfile is
+/// skipped, so even huge tagfiles can be indexed without loading them.
+class tagfile_index : public inventory {
+ public:
+  struct location {
+    /// The HTML page documenting the entity relative to the root of the
+    /// documentation. Owned by the index since many entities share a page.
+    std::string_view filename;
+
+    /// The anchor of the entity on that page if the entity does not have a
+    /// page of its own.
+    std::string anchor;
+  };
+
+  tagfile_index() = default;
+
+  // The locations refer to the pages that this index owns, so an index can
+  // be moved but not copied.
+  tagfile_index(tagfile_index&&) = default;
+  tagfile_index& operator=(tagfile_index&&) = default;
+  tagfile_index(const tagfile_index&) = delete;
+  tagfile_index& operator=(const tagfile_index&) = delete;
+
+  static tagfile_index parse(const std::string& fname);
+
+  friend std::istream& operator>>(std::istream&, tagfile_index&);
+
+  /// Record that `name` is documented on the page `filename` at `anchor`
+  /// unless there is already an entity of that name.
+  void add(std::string name, std::string_view filename, std::string anchor);
+
+  /// Return the location of the entity with the fully qualified `name`.
+  type_safe::optional_ref<const location> find(const std::string& name) const;
+
+  /// Return the number of entities in this index.
+  std::size_t size() const;
+
+  /// Return an estimate of the bytes that this index occupies.
+  std::size_t memory() const;
+
+  auto begin() const { return names.begin(); }
+  auto end() const { return names.end(); }
+
+ private:
+  std::unordered_set<std::string> pages;
+
+  std::unordered_map<std::string, location> names;
+};
+
+}
+
+#endif
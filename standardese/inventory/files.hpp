@@ -5,8 +5,11 @@
 #ifndef STANDARDESE_INVENTORY_FILES_HPP_INCLUDED
 #define STANDARDESE_INVENTORY_FILES_HPP_INCLUDED
 
-#include <unordered_set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include <boost/filesystem/path.hpp>
 #include <cppast/forward.hpp>
 #include <type_safe/optional_ref.hpp>
 
@@ -36,7 +39,15 @@ class files {
   type_safe::optional_ref<const cppast::cpp_file> find_header(const std::string& name, const std::string& path) const;
 
  private:
-  std::unordered_set<const cppast::cpp_file*> headers;
+  /// The directory that names are relative to if there is no other context.
+  boost::filesystem::path working_directory;
+
+  /// The headers by their absolute normalized path.
+  std::unordered_map<std::string, const cppast::cpp_file*> paths;
+
+  /// The headers by all the trailing parts of their paths, e.g., `c.hpp`,
+  /// `b/c.hpp`, and `a/b/c.hpp` for `/a/b/c.hpp`.
+  std::unordered_map<std::string, const cppast::cpp_file*> suffixes;
 };
 
 }
@@ -7,6 +7,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <type_safe/optional.hpp>
 
@@ -18,6 +19,9 @@ namespace standardese::inventory::sphinx {
 /// See
 /// [inventory.py](https://github.com/sphinx-doc/sphinx/blob/4.x/sphinx/util/inventory.py#L147)
 /// for the place in sphinx where these lines are rendered.
+/// Entries own their strings. Most names appear only once in an inventory,
+/// so interning them as [model::interned_string]() would only grow that
+/// table without sharing anything.
 class entry {
  public:
   entry(std::string name, std::string domain, std::string type, long priority, std::string uri, std::string display_name);
@@ -31,6 +35,25 @@ class entry {
   std::string display_name;
 };
 
+/// Call `f` with each trailing part of the qualified `name` that starts after
+/// a `::` or `.` separator, e.g., with `vector::push_back` and `push_back`
+/// for `std::vector::push_back`.
+template <typename F>
+void for_each_suffix(std::string_view name, F&& f) {
+  for (std::size_t i = 0; i < name.size(); i++) {
+    std::size_t start;
+    if (name[i] == '.')
+      start = i + 1;
+    else if (name.compare(i, 2, "::") == 0)
+      start = i + 2;
+    else
+      continue;
+
+    if (start < name.size())
+      f(name.substr(start));
+  }
+}
+
 }
 
 #endif
@@ -0,0 +1,81 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_INVENTORY_SPHINX_MAPPED_DOCUMENTATION_SET_HPP_INCLUDED
+#define STANDARDESE_INVENTORY_SPHINX_MAPPED_DOCUMENTATION_SET_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <type_safe/optional.hpp>
+
+#include "entry.hpp"
+#include "../inventory.hpp"
+
+namespace standardese::inventory::sphinx {
+
+/// A [documentation_set]() in a compact binary format that is memory mapped
+/// read-only from disk.
+///
+/// Loading an intersphinx inventory means inflating and parsing it. The
+/// binary format instead contains a table of all the strings and hash
+/// indexes for the lookups that [symbols]() performs, so it can be used
+/// without reading it into memory first. Only the entries that are actually
+/// found are copied out of it.
+class mapped_documentation_set : public inventory {
+ public:
+  /// Return the binary inventory at `path` if it has been written for an
+  /// intersphinx inventory whose contents have the `hash`.
+  static type_safe::optional<mapped_documentation_set> open(const boost::filesystem::path& path, const std::string& hash);
+
+  /// Write `inventory` in the binary format to `path` and record that it has
+  /// been created from an intersphinx inventory whose contents have the `hash`.
+  static void write(const boost::filesystem::path& path, const struct documentation_set& inventory, const std::string& hash);
+
+  std::string_view project() const;
+  std::string_view version() const;
+
+  /// Return the number of entries in this inventory.
+  std::size_t size() const;
+
+  /// Return the entry called `name` with the best priority.
+  type_safe::optional<entry> find(std::string_view name) const;
+
+  /// Return the entry with the best priority whose qualified name ends in
+  /// `name`, e.g., `std::vector::push_back` for `vector::push_back`, if no
+  /// other entry with that priority also ends in `name`.
+  type_safe::optional<entry> find_suffix(std::string_view name) const;
+
+ private:
+  struct header;
+  struct string;
+  struct record;
+  struct slot;
+
+  explicit mapped_documentation_set(boost::iostreams::mapped_file_source);
+
+  /// Return whether all the strings and records that this inventory refers
+  /// to are within the mapped file.
+  bool valid() const;
+
+  const header& head() const;
+  const record* records() const;
+  const slot* names() const;
+  const slot* suffixes() const;
+  std::string_view str(const string&) const;
+  entry materialize(const record&) const;
+
+  /// Return the slot in the hash index `slots` of size `count` whose key is
+  /// `name` or `nullptr` if there is no such slot.
+  const slot* probe(const slot* slots, std::uint32_t count, std::string_view name) const;
+
+  boost::iostreams::mapped_file_source file;
+};
+
+}
+
+#endif
@@ -9,10 +9,13 @@
 #include "inventory.hpp"
 #include "../model/link_target.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <cppast/forward.hpp>
 #include <type_safe/optional_ref.hpp>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 namespace standardese::inventory
 {
@@ -47,6 +50,33 @@ class symbols {
   /// Lookup the global symbol `name`.
   type_safe::optional<model::link_target> find(const std::string& name) const;
 
+  /// A single lookup in a batch of lookups, see
+  /// [find](standardese::inventory::symbols::find(std::vector<lookup>&) const).
+  struct lookup {
+    lookup(std::string name, type_safe::optional_ref<const cppast::cpp_entity> scope = type_safe::nullopt);
+
+    /// The symbol to look up.
+    std::string name;
+
+    /// The entity that `name` is looked up relative to, or none to look up
+    /// a global symbol.
+    type_safe::optional_ref<const cppast::cpp_entity> scope;
+
+    /// The result of the lookup, unset if `name` could not be found.
+    type_safe::optional<model::link_target> target;
+  };
+
+  /// Perform all the `lookups` and write their results to their `target`.
+  /// The results are the same as with the other overloads of `find`.
+  /// However, the lookups are sorted by scope and name first so that
+  /// identical lookups are only performed once and lookups of names that
+  /// share a scope and a leading qualifier, such as `X::f` and `X::g`,
+  /// resolve that qualifier only once.
+  void find(std::vector<lookup>& lookups) const;
+
+  /// Return an estimate of the memory used by the lookup tables in bytes.
+  std::size_t memory() const;
+
  private:
   struct impl;
 
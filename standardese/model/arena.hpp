@@ -0,0 +1,124 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_MODEL_ARENA_HPP_INCLUDED
+#define STANDARDESE_MODEL_ARENA_HPP_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace standardese::model
+{
+
+/// A memory resource that the [entity]() instances of the model and the
+/// lists of children of their containers can be allocated in.
+/// Allocations are carved out of large slabs, one sequence of slabs per
+/// thread, and never freed individually. All the memory is released at once
+/// when the arena is destroyed, so the arena must outlive all the entities
+/// that were allocated in it.
+class arena : public std::pmr::memory_resource {
+  public:
+    arena();
+    ~arena() override;
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    /// Allocates the model entities that the calling thread creates in an
+    /// [arena]() while it is alive.
+    /// Copies of entities that are made outside of a scope, e.g., when a
+    /// shared entity is modified, are allocated on the heap again. However,
+    /// the lists of children that were created in the arena keep allocating
+    /// from it when they grow.
+    /// Scopes must be nested properly.
+    class scope {
+      public:
+        explicit scope(arena&);
+        ~scope();
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+      private:
+        arena* previous;
+    };
+
+    /// Return the arena that the calling thread allocates new model entities
+    /// in, if any.
+    static arena* active() noexcept;
+
+    /// Return the resource that the calling thread allocates new lists of
+    /// children in, i.e., the [active]() arena or the default resource.
+    static std::pmr::memory_resource* resource() noexcept;
+
+    /// Create a reference counted `E` from `args` in `arena` or, if there is
+    /// no `arena`, on the heap.
+    template <typename E, typename ...Args>
+    static std::shared_ptr<E> make_shared(arena* arena, Args&&... args) {
+      if (arena)
+        return std::allocate_shared<E>(std::pmr::polymorphic_allocator<E>(arena), std::forward<Args>(args)...);
+      return std::make_shared<E>(std::forward<Args>(args)...);
+    }
+
+    /// Return the number of bytes of the slabs that this arena has reserved.
+    std::size_t memory() const;
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override;
+    bool do_is_equal(const std::pmr::memory_resource&) const noexcept override;
+
+    /// Return the slabs that the calling thread allocates from.
+    std::pmr::monotonic_buffer_resource& slabs();
+
+    /// A unique identifier of this arena, used to tell arenas apart that
+    /// live at the same address one after another.
+    const std::uint64_t id;
+
+    mutable std::mutex mutex;
+
+    /// Hands out the slabs from the heap and records their size.
+    class upstream : public std::pmr::memory_resource {
+      public:
+        std::atomic<std::size_t> reserved = 0;
+
+      private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void*, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource&) const noexcept override;
+    } upstream;
+
+    /// The slabs of each thread that allocated from this arena.
+    std::unordered_map<std::thread::id, std::unique_ptr<std::pmr::monotonic_buffer_resource>> threads;
+};
+
+/// The arenas that the documents of a run are allocated in, one for each
+/// document, so that the arena of a document only holds what was created
+/// for that document.
+class arenas {
+  public:
+    /// Return a new arena that lives as long as this collection.
+    /// Arenas can be created from any thread concurrently.
+    arena& create();
+
+    /// Return the number of bytes of the slabs that all arenas have
+    /// reserved.
+    std::size_t memory() const;
+
+  private:
+    mutable std::mutex mutex;
+
+    std::deque<arena> values;
+};
+}
+
+#endif
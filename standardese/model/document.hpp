@@ -5,6 +5,7 @@
 #ifndef STANDARDESE_MODEL_DOCUMENT_HPP_INCLUDED
 #define STANDARDESE_MODEL_DOCUMENT_HPP_INCLUDED
 
+#include "interned_string.hpp"
 #include "mixin/visitable.hpp"
 #include "mixin/anchored_container.hpp"
 
@@ -15,16 +16,16 @@ namespace standardese::model
       public:
         // TODO: Since we are using unnamed documents as containers frequently, it might make sense to have an explicit default constructor as well.
         template <typename ...Args>
-        document(std::string name, std::string path, Args&&... args) : name(std::move(name)), path(std::move(path)), mixin::anchored_container<>(std::forward<Args>(args)...) {}
+        document(interned_string name, interned_string path, Args&&... args) : name(name), path(path), mixin::anchored_container<>(std::forward<Args>(args)...) {}
 
         /// A (unique) symbolic base name for this document.
         /// The final output name without the suffix.
-        std::string name;
+        interned_string name;
 
         /// The relative path of this document relative to some document
         /// root for the purpose of linking such as the relative URL of some
         /// HTTP endpoint that will serve this document eventually.
-        std::string path;
+        interned_string path;
     };
 }
 
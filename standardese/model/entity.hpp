@@ -6,36 +6,56 @@
 #ifndef STANDARDESE_MODEL_ERASED_ENTITY_HPP_INCLUDED
 #define STANDARDESE_MODEL_ERASED_ENTITY_HPP_INCLUDED
 
+#include <atomic>
 #include <stdexcept>
 #include <memory>
 #include <type_traits>
 
+#include "arena.hpp"
+#include "../stats.hpp"
 #include "visitor/visitor.hpp"
 #include "mixin/visitable.hpp"
 
 namespace standardese::model
 {
 
+/// A node of the documentation model, e.g., a paragraph or the documentation
+/// of a C++ entity, together with its children.
+/// Entities that have been cloned share their value until one of them is
+/// modified, i.e., until its non-const accessors are used. Only then is the
+/// value copied. The children of that copy are again shared.
 class entity {
   public:
     // TODO: This implicit cast is maybe not such a great idea. It can be quite confusing when it happens. And it implies a copy being created.
     template <typename E, std::enable_if_t<std::is_base_of_v<mixin::ivisitable, std::decay_t<E>>, bool> Enabled = true>
-    entity(E&& e) : value(new std::decay_t<E>(std::forward<E>(e))) {}
+    entity(E&& e) : value(arena::make_shared<std::decay_t<E>>(arena::active(), std::forward<E>(e))) {}
 
-    entity(const entity& rhs) : value(rhs.value->clone()) {}
-    entity(entity&& rhs) : value(std::move(rhs.value)) {}
+    // Copies must be requested explicitly with clone().
+    entity(const entity&) = delete;
+    entity(entity&& rhs) noexcept : value(std::move(rhs.value)) {}
 
-    entity& operator=(entity& rhs) {
-      value.reset(rhs.value->clone());
-      return *this;
-    }
+    entity& operator=(const entity&) = delete;
 
-    entity& operator=(entity&& rhs) {
+    entity& operator=(entity&& rhs) noexcept {
       value = std::move(rhs.value);
       return *this;
     }
 
+    /// Return a copy of this entity and its children.
+    /// The copy shares its value with this entity until either is modified.
+    /// Each cloned entity is counted in the `--stats`.
+    entity clone() const {
+      ++cloned;
+      return entity(value);
+    }
+
+    /// Visit this entity with a visitor that may modify it.
+    /// Since the visitor could modify any node, every node it visits is
+    /// copied if it is shared. Passes that only read should visit a const
+    /// entity, and passes that modify only a few nodes should use a
+    /// [flat_document]() instead.
     void accept(visitor::visitor<false>& visitor) {
+        detach();
         value->accept(visitor);
     }
 
@@ -58,6 +78,7 @@ class entity {
 
     template <typename T>
     T& as() {
+      detach();
       return const_cast<T&>(const_cast<const entity&>(*this).as<T>());
     }
 
@@ -67,7 +88,26 @@ class entity {
     }
 
   private:
-    std::unique_ptr<mixin::ivisitable> value;
+    explicit entity(std::shared_ptr<mixin::ivisitable> value) : value(std::move(value)) {}
+
+    /// Make sure that the value of this entity is not shared with any other
+    /// entity so that it can be modified.
+    void detach() {
+      if (value.use_count() == 1) {
+        // Another thread might just have stopped reading this value when it
+        // released its reference to it.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return;
+      }
+
+      ++copied;
+      value = value->clone(arena::active());
+    }
+
+    std::shared_ptr<mixin::ivisitable> value;
+
+    inline static stats::counter cloned{"model: cloned entities"};
+    inline static stats::counter copied{"model: copied entities"};
 };
 
 }
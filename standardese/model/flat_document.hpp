@@ -0,0 +1,245 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_MODEL_FLAT_DOCUMENT_HPP_INCLUDED
+#define STANDARDESE_MODEL_FLAT_DOCUMENT_HPP_INCLUDED
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "entity.hpp"
+#include "document.hpp"
+#include "section.hpp"
+#include "module.hpp"
+#include "cpp_entity_documentation.hpp"
+#include "group_documentation.hpp"
+#include "markup/block_quote.hpp"
+#include "markup/code.hpp"
+#include "markup/code_block.hpp"
+#include "markup/emphasis.hpp"
+#include "markup/hard_break.hpp"
+#include "markup/heading.hpp"
+#include "markup/image.hpp"
+#include "markup/link.hpp"
+#include "markup/list.hpp"
+#include "markup/list_item.hpp"
+#include "markup/paragraph.hpp"
+#include "markup/soft_break.hpp"
+#include "markup/strong_emphasis.hpp"
+#include "markup/text.hpp"
+#include "markup/thematic_break.hpp"
+
+namespace standardese::model
+{
+
+/// The type of a node in a [flat_document]().
+enum class node_kind : unsigned char {
+  block_quote,
+  code,
+  code_block,
+  emphasis,
+  cpp_entity_documentation,
+  group_documentation,
+  hard_break,
+  heading,
+  link,
+  list,
+  list_item,
+  module,
+  paragraph,
+  section,
+  soft_break,
+  strong_emphasis,
+  text,
+  thematic_break,
+  document,
+  image,
+};
+
+/// A compact index of an [entity]() and all its descendants that passes over
+/// an entire document can iterate over in a plain loop instead of visiting
+/// each node through a chain of virtual calls.
+/// The nodes are numbered in pre-order, starting with the root at 0, so the
+/// descendants of a node `n` are the nodes in `[n + 1, end(n))`. For each
+/// node, the index stores its kind, its parent, first child, and next
+/// sibling, and a pointer to the actual node which can be read through
+/// [get]() and modified through [as]() or [visit](). The values of all the
+/// text nodes are copied into a single string in the same order, so the text
+/// of a subtree is a contiguous part of that string, see [text]().
+/// Building the index does not modify the entity. Nodes that are shared with
+/// other entities, see [entity::clone](), are only copied once they are
+/// modified through [as]() or [visit](). Then the node and its ancestors are
+/// copied if they are still shared.
+/// The index is a snapshot of the structure and text of the entity. It must
+/// not be used anymore once nodes have been added or removed.
+template <bool is_const = false>
+class flat_document {
+    template <typename T>
+    using conditional_const = std::conditional_t<is_const, const T, T>;
+
+  public:
+    using index = std::uint32_t;
+
+    /// The index of a node that does not exist, e.g., the parent of the
+    /// root.
+    static constexpr index none = std::numeric_limits<index>::max();
+
+    /// Create an index of `root` and all its descendants.
+    /// Unless `text` is set, the values of the text nodes are not collected,
+    /// which saves a copy of all the text in passes that do not need
+    /// [text]().
+    explicit flat_document(conditional_const<entity>& root, bool text = true);
+
+    /// Return the number of nodes in this index.
+    index size() const noexcept { return static_cast<index>(kinds.size()); }
+
+    node_kind kind(index node) const { return kinds[node]; }
+    index parent(index node) const { return parents[node]; }
+    index first_child(index node) const { return first_children[node]; }
+    index next_sibling(index node) const { return next_siblings[node]; }
+
+    /// Return the node after the last descendant of `node`.
+    index end(index node) const { return ends[node]; }
+
+    /// Return the concatenated values of all the text nodes in the subtree
+    /// of `node`.
+    std::string_view text(index node) const {
+      if (offsets.empty())
+        throw std::logic_error("text nodes have not been collected for this index");
+      return std::string_view(strings).substr(offsets[node], offsets[ends[node]] - offsets[node]);
+    }
+
+    /// Return the closest ancestor of `node` of kind `kind`, if any, or
+    /// [none]().
+    index ancestor(index node, node_kind kind) const {
+      for (node = parents[node]; node != none; node = parents[node])
+        if (kinds[node] == kind)
+          return node;
+      return none;
+    }
+
+    /// Return `node` which must be of type `T` without modifying it.
+    template <typename T>
+    const T& get(index node) const {
+      if (kinds[node] != kind_of(static_cast<T*>(nullptr)))
+        throw std::invalid_argument("this node is not of the required type");
+      return *static_cast<const T*>(nodes[node]);
+    }
+
+    /// Return `node` which must be of type `T`.
+    /// Unless the index is const, the node and its ancestors are copied
+    /// first if they are shared with another entity.
+    template <typename T>
+    conditional_const<T>& as(index node) const {
+      if (kinds[node] != kind_of(static_cast<T*>(nullptr)))
+        throw std::invalid_argument("this node is not of the required type");
+      detach(node);
+      return *static_cast<conditional_const<T>*>(nodes[node]);
+    }
+
+    /// Call `f` with `node` cast to its actual type.
+    /// Unless the index is const, the node and its ancestors are copied
+    /// first if they are shared with another entity.
+    template <typename F>
+    decltype(auto) visit(index node, F&& f) const {
+      detach(node);
+      return dispatch(node, std::forward<F>(f));
+    }
+
+    static constexpr node_kind kind_of(const markup::block_quote*) { return node_kind::block_quote; }
+    static constexpr node_kind kind_of(const markup::code*) { return node_kind::code; }
+    static constexpr node_kind kind_of(const markup::code_block*) { return node_kind::code_block; }
+    static constexpr node_kind kind_of(const markup::emphasis*) { return node_kind::emphasis; }
+    static constexpr node_kind kind_of(const model::cpp_entity_documentation*) { return node_kind::cpp_entity_documentation; }
+    static constexpr node_kind kind_of(const model::group_documentation*) { return node_kind::group_documentation; }
+    static constexpr node_kind kind_of(const markup::hard_break*) { return node_kind::hard_break; }
+    static constexpr node_kind kind_of(const markup::heading*) { return node_kind::heading; }
+    static constexpr node_kind kind_of(const markup::link*) { return node_kind::link; }
+    static constexpr node_kind kind_of(const markup::list*) { return node_kind::list; }
+    static constexpr node_kind kind_of(const markup::list_item*) { return node_kind::list_item; }
+    static constexpr node_kind kind_of(const model::module*) { return node_kind::module; }
+    static constexpr node_kind kind_of(const markup::paragraph*) { return node_kind::paragraph; }
+    static constexpr node_kind kind_of(const model::section*) { return node_kind::section; }
+    static constexpr node_kind kind_of(const markup::soft_break*) { return node_kind::soft_break; }
+    static constexpr node_kind kind_of(const markup::strong_emphasis*) { return node_kind::strong_emphasis; }
+    static constexpr node_kind kind_of(const markup::text*) { return node_kind::text; }
+    static constexpr node_kind kind_of(const markup::thematic_break*) { return node_kind::thematic_break; }
+    static constexpr node_kind kind_of(const model::document*) { return node_kind::document; }
+    static constexpr node_kind kind_of(const markup::image*) { return node_kind::image; }
+
+  private:
+    struct builder;
+
+    template <typename T>
+    conditional_const<T>& cast(index node) const {
+      assert(kinds[node] == kind_of(static_cast<T*>(nullptr)));
+      return *static_cast<conditional_const<T>*>(nodes[node]);
+    }
+
+    /// Call `f` with `node` cast to its actual type without copying it.
+    template <typename F>
+    decltype(auto) dispatch(index node, F&& f) const {
+      switch (kinds[node]) {
+        case node_kind::block_quote: return f(cast<markup::block_quote>(node));
+        case node_kind::code: return f(cast<markup::code>(node));
+        case node_kind::code_block: return f(cast<markup::code_block>(node));
+        case node_kind::emphasis: return f(cast<markup::emphasis>(node));
+        case node_kind::cpp_entity_documentation: return f(cast<model::cpp_entity_documentation>(node));
+        case node_kind::group_documentation: return f(cast<model::group_documentation>(node));
+        case node_kind::hard_break: return f(cast<markup::hard_break>(node));
+        case node_kind::heading: return f(cast<markup::heading>(node));
+        case node_kind::link: return f(cast<markup::link>(node));
+        case node_kind::list: return f(cast<markup::list>(node));
+        case node_kind::list_item: return f(cast<markup::list_item>(node));
+        case node_kind::module: return f(cast<model::module>(node));
+        case node_kind::paragraph: return f(cast<markup::paragraph>(node));
+        case node_kind::section: return f(cast<model::section>(node));
+        case node_kind::soft_break: return f(cast<markup::soft_break>(node));
+        case node_kind::strong_emphasis: return f(cast<markup::strong_emphasis>(node));
+        case node_kind::text: return f(cast<markup::text>(node));
+        case node_kind::thematic_break: return f(cast<markup::thematic_break>(node));
+        case node_kind::document: return f(cast<model::document>(node));
+        case node_kind::image: return f(cast<markup::image>(node));
+      }
+      throw std::logic_error("unexpected node kind");
+    }
+
+    /// Make sure that `node` and its ancestors are not shared with any
+    /// other entity so that `node` can be modified.
+    void detach(index node) const;
+
+    std::vector<node_kind> kinds;
+    std::vector<index> parents;
+    std::vector<index> first_children;
+    std::vector<index> next_siblings;
+    std::vector<index> ends;
+
+    /// The entity that has been indexed.
+    conditional_const<entity>* root;
+
+    /// Pointers to the nodes. When a node is copied because it is
+    /// modified, the pointer is updated, see [detach]().
+    mutable std::vector<conditional_const<void>*> nodes;
+
+    /// Whether a node is known not to be shared with other entities.
+    mutable std::vector<bool> detached;
+
+    /// The position in `strings` where the text of each node starts
+    /// followed by the size of `strings`; empty if text nodes are not
+    /// collected.
+    std::vector<std::uint32_t> offsets;
+
+    /// The values of all text nodes in pre-order.
+    std::string strings;
+};
+
+}
+
+#endif
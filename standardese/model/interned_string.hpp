@@ -0,0 +1,74 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_MODEL_INTERNED_STRING_HPP_INCLUDED
+#define STANDARDESE_MODEL_INTERNED_STRING_HPP_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace standardese::model
+{
+
+/// A handle to a string in a table that is shared by the entire run, such as
+/// the id of an anchor or the target of a link.
+/// Equal strings are stored only once in that table so two handles are equal
+/// if and only if they refer to the same entry. Comparing and hashing handles
+/// therefore only needs to look at a single pointer and copying a handle
+/// never allocates.
+/// Strings can be interned from any thread concurrently. Interned strings
+/// are never released.
+class interned_string {
+  public:
+    /// Create a handle to the empty string.
+    interned_string() noexcept;
+
+    interned_string(std::string_view value);
+    interned_string(const std::string& value) : interned_string(std::string_view(value)) {}
+    interned_string(const char* value) : interned_string(std::string_view(value)) {}
+
+    const std::string& str() const noexcept { return *value; }
+    operator const std::string&() const noexcept { return *value; }
+
+    const char* c_str() const noexcept { return value->c_str(); }
+    bool empty() const noexcept { return value->empty(); }
+    std::size_t size() const noexcept { return value->size(); }
+
+    /// Return an estimate of the memory used by all the strings interned so
+    /// far in bytes.
+    static std::size_t memory();
+
+    friend bool operator==(interned_string lhs, interned_string rhs) noexcept { return lhs.value == rhs.value; }
+    friend bool operator!=(interned_string lhs, interned_string rhs) noexcept { return lhs.value != rhs.value; }
+
+    friend bool operator==(interned_string lhs, std::string_view rhs) noexcept { return *lhs.value == rhs; }
+    friend bool operator!=(interned_string lhs, std::string_view rhs) noexcept { return *lhs.value != rhs; }
+    friend bool operator==(interned_string lhs, const std::string& rhs) noexcept { return *lhs.value == rhs; }
+    friend bool operator!=(interned_string lhs, const std::string& rhs) noexcept { return *lhs.value != rhs; }
+    friend bool operator==(interned_string lhs, const char* rhs) noexcept { return *lhs.value == rhs; }
+    friend bool operator!=(interned_string lhs, const char* rhs) noexcept { return *lhs.value != rhs; }
+
+    friend bool operator==(std::string_view lhs, interned_string rhs) noexcept { return rhs == lhs; }
+    friend bool operator!=(std::string_view lhs, interned_string rhs) noexcept { return rhs != lhs; }
+    friend bool operator==(const std::string& lhs, interned_string rhs) noexcept { return rhs == lhs; }
+    friend bool operator!=(const std::string& lhs, interned_string rhs) noexcept { return rhs != lhs; }
+    friend bool operator==(const char* lhs, interned_string rhs) noexcept { return rhs == lhs; }
+    friend bool operator!=(const char* lhs, interned_string rhs) noexcept { return rhs != lhs; }
+
+  private:
+    const std::string* value;
+};
+
+}
+
+template <>
+struct std::hash<standardese::model::interned_string> {
+  std::size_t operator()(standardese::model::interned_string value) const noexcept {
+    return std::hash<const std::string*>()(&value.str());
+  }
+};
+
+#endif
@@ -10,6 +10,8 @@
 #include <type_safe/reference.hpp>
 #include <type_safe/optional_ref.hpp>
 
+#include "../forward.hpp"
+#include "interned_string.hpp"
 #include "../inventory/sphinx/documentation_set.hpp"
 
 namespace standardese::model
@@ -24,9 +26,9 @@ namespace standardese::model
 class link_target {
   public:
     struct standardese_target {
-      standardese_target(std::string target);
+      standardese_target(interned_string target);
 
-      std::string target;
+      interned_string target;
     };
 
     struct module_target {
@@ -43,6 +45,7 @@ class link_target {
 
     struct sphinx_target {
       sphinx_target(const inventory::sphinx::documentation_set&, inventory::sphinx::entry entry);
+      sphinx_target(const inventory::sphinx::mapped_documentation_set&, inventory::sphinx::entry entry);
 
       std::string project;
       std::string version;
@@ -50,16 +53,32 @@ class link_target {
     };
 
     struct doxygen_target {
+      doxygen_target(const inventory::doxygen::tagfile_index&, std::string name, std::string filename, std::string anchor);
+      doxygen_target(const inventory::doxygen::mapped_tagfile_index&, std::string name, std::string filename, std::string anchor);
+
+      /// The index of the tagfile that this target was found in, either a
+      /// [inventory::doxygen::tagfile_index]() or its memory mapped form.
+      type_safe::object_ref<const inventory::inventory> inventory;
+
+      std::string name;
+
+      /// The HTML file documenting the entity relative to the root of the
+      /// external documentation.
+      std::string filename;
+
+      /// The anchor of the entity in `filename` if the entity does not have
+      /// a page of its own.
+      std::string anchor;
     };
 
     struct uri_target {
-      explicit uri_target(std::string uri);
+      explicit uri_target(interned_string uri);
 
-      std::string uri;
+      interned_string uri;
     };
 
     /// Create a link from input in MarkDown with standardese syntax.
-    explicit link_target(std::string target);
+    explicit link_target(interned_string target);
 
     /// Create a link to the module `module`.
     link_target(module_target module);
@@ -5,7 +5,7 @@
 #ifndef STANDARDESE_MODEL_MIXIN_ANCHORED_HPP_INCLUDED
 #define STANDARDESE_MODEL_MIXIN_ANCHORED_HPP_INCLUDED
 
-#include <string>
+#include "../interned_string.hpp"
 
 namespace standardese::model::mixin
 {
@@ -13,7 +13,7 @@ namespace standardese::model::mixin
     class anchored
     {
     public:
-        std::string id;
+        interned_string id;
     };
 }
 
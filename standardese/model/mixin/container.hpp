@@ -6,6 +6,8 @@
 #ifndef STANDARDESE_MODEL_MIXIN_CONTAINER_HPP_INCLUDED
 #define STANDARDESE_MODEL_MIXIN_CONTAINER_HPP_INCLUDED
 
+#include <memory_resource>
+#include <type_traits>
 #include <vector>
 
 #include "../entity.hpp"
@@ -33,17 +35,45 @@ namespace standardese::model::mixin
           return std::forward<S>(s);
         }
 
+        static T copy(const T& child) {
+          if constexpr (std::is_same_v<T, model::entity>)
+            return child.clone();
+          else
+            return child;
+        }
+
     public:
         using entity = T;
-        using iterator = typename std::vector<T>::iterator;
-        using const_iterator = typename std::vector<T>::const_iterator;
-        using reverse_iterator = typename std::vector<T>::reverse_iterator;
-        using const_reverse_iterator = typename std::vector<T>::const_reverse_iterator;
+        using iterator = typename std::pmr::vector<T>::iterator;
+        using const_iterator = typename std::pmr::vector<T>::const_iterator;
+        using reverse_iterator = typename std::pmr::vector<T>::reverse_iterator;
+        using const_reverse_iterator = typename std::pmr::vector<T>::const_reverse_iterator;
 
-        container() noexcept = default;
+        container() noexcept : children_(arena::resource()) {}
 
         template <typename ...Args>
-        explicit container(Args&&... args) : children_{convert(std::forward<Args>(args))...} {}
+        explicit container(Args&&... args) : children_(arena::resource()) {
+            children_.reserve(sizeof...(args));
+            (children_.push_back(convert(std::forward<Args>(args))), ...);
+        }
+
+        /// Create a copy of `rhs`, i.e., clone all its children.
+        /// The children are shared until they are modified, see [entity]().
+        container(const container& rhs) : children_(arena::resource()) {
+            children_.reserve(rhs.children_.size());
+            for (const auto& child : rhs.children_)
+                children_.push_back(copy(child));
+        }
+
+        container(container&&) noexcept = default;
+
+        container& operator=(const container& rhs) {
+            if (this != &rhs)
+                *this = container(rhs);
+            return *this;
+        }
+
+        container& operator=(container&&) noexcept = default;
 
         // TODO: Rename to emplace_back()
         template <typename ...Args>
@@ -125,7 +155,9 @@ namespace standardese::model::mixin
         // glue anymore? Or should we instead expose the entire vector
         // interface here and check NDEBUG that children are of expected
         // types? Such as, lists contain only list items...
-        std::vector<T> children_;
+        // The children are allocated in the [arena]() of the
+        // [arena::scope]() that was active when the container was created.
+        std::pmr::vector<T> children_;
     };
 }
 
@@ -5,7 +5,10 @@
 #ifndef STANDARDESE_MODEL_MIXIN_VISITABLE_HPP_INCLUDED
 #define STANDARDESE_MODEL_MIXIN_VISITABLE_HPP_INCLUDED
 
+#include <memory>
+
 #include "../visitor/visitor.hpp"
+#include "../arena.hpp"
 
 namespace standardese::model::mixin
 {
@@ -15,7 +18,10 @@ public:
   virtual void accept(visitor::visitor<false>& visitor) = 0;
   virtual void accept(visitor::visitor<true>& visitor) const = 0;
 
-  virtual ivisitable* clone() const = 0;
+  /// Return a copy of this entity, allocated in `arena` or, if there is no
+  /// `arena`, on the heap.
+  /// The children of the copy are shared with this entity, see [entity]().
+  virtual std::shared_ptr<ivisitable> clone(arena* arena) const = 0;
 
   virtual ~ivisitable() {};
 };
@@ -32,8 +38,8 @@ public:
         visitor.visit(*static_cast<const E*>(this));
     }
 
-    ivisitable* clone() const override {
-        return new E(*static_cast<const E*>(this));
+    std::shared_ptr<ivisitable> clone(arena* arena) const override {
+        return arena::make_shared<E>(arena, *static_cast<const E*>(this));
     }
 };
 
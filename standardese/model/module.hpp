@@ -6,6 +6,7 @@
 #ifndef STANDARDESE_MODEL_MODULE_DOCUMENTATION_HPP_INCLUDED
 #define STANDARDESE_MODEL_MODULE_DOCUMENTATION_HPP_INCLUDED
 
+#include "interned_string.hpp"
 #include "mixin/visitable.hpp"
 #include "mixin/documentation.hpp"
 
@@ -16,9 +17,9 @@ namespace standardese::model
     {
       public:
         template <typename ...Args>
-        module(std::string name, Args&&... args) : name(std::move(name)), mixin::documentation(std::forward<Args>(args)...) {}
+        module(interned_string name, Args&&... args) : name(name), mixin::documentation(std::forward<Args>(args)...) {}
 
-        std::string name;
+        interned_string name;
     };
 }
 
@@ -6,7 +6,10 @@
 #define STANDARDESE_MODEL_ENTITIES_HPP_INCLUDED
 
 #include <cppast/forward.hpp>
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <type_traits>
 
 #include "../forward.hpp"
 
@@ -35,8 +38,9 @@ class unordered_entities {
 
     unordered_entities& operator=(unordered_entities&&) noexcept;
 
-    template <typename R>
-    explicit unordered_entities(const R& args) : unordered_entities(args.begin(), args.end()) {}
+    /// Create from a range of entities which are moved into this set.
+    template <typename R, typename = std::enable_if_t<!std::is_reference_v<R>>>
+    explicit unordered_entities(R&& args) : unordered_entities(std::make_move_iterator(args.begin()), std::make_move_iterator(args.end())) {}
 
     template <typename It>
     unordered_entities(It begin, It end) : unordered_entities() {
@@ -72,6 +76,12 @@ class unordered_entities {
     template <bool is_const>
     class unordered_iterator {
      public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = entity;
+      using difference_type = std::ptrdiff_t;
+      using pointer = std::conditional_t<is_const, const entity*, entity*>;
+      using reference = std::conditional_t<is_const, const entity&, entity&>;
+
       unordered_iterator(const unordered_iterator&) noexcept;
       unordered_iterator(unordered_iterator&&) noexcept;
       ~unordered_iterator() noexcept;
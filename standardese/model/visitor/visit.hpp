@@ -5,6 +5,9 @@
 #ifndef STANDARDESE_MODEL_VISITOR_VISIT_HPP_INCLUDED
 #define STANDARDESE_MODEL_VISITOR_VISIT_HPP_INCLUDED
 
+#include <stack>
+#include <vector>
+
 #include "visitor.hpp"
 #include "detail/visit.hpp"
 #include "../entity.hpp"
@@ -17,6 +20,43 @@ auto visit(T&& lambda, E&& e) {
   return detail::visit(std::forward<T>(lambda), std::forward<E>(e));
 }
 
+/// The new children of the containers that a visitor is in while it
+/// rebuilds a tree of entities, e.g., to drop, regroup, or insert entities.
+/// Since entities cannot be copied, each container is emptied once its
+/// children have been visited and filled with the entities that were moved
+/// to it in the meantime.
+class rebuilt_containers {
+  public:
+    rebuilt_containers() { containers.push({}); }
+
+    /// Start collecting the new children of a container.
+    void enter() { containers.push({}); }
+
+    /// Replace the children of `container` with the ones collected since
+    /// the matching [enter]().
+    template <typename T>
+    void leave(T& container) {
+      container.clear();
+      for (auto& child : containers.top())
+        container.emplace_child(std::move(child));
+      containers.pop();
+    }
+
+    /// Move `entity` to the container that the visitor is currently in.
+    /// The root of the tree has no parent so it is left in place.
+    template <typename T>
+    void keep(T&& entity) {
+      if (containers.size() > 1)
+        containers.top().emplace_back(std::forward<T>(entity));
+    }
+
+    /// Return the children collected for the current container so far.
+    std::vector<entity>& top() { return containers.top(); }
+
+  private:
+    std::stack<std::vector<entity>> containers;
+};
+
 }
 
 #endif
@@ -13,27 +13,49 @@
 namespace standardese::output_generator::sphinx
 {
 
-class inventory_generator : public stream_generator {
+/// Collects the entries of an intersphinx inventory for the documents it
+/// visits.
+/// Unlike the [inventory_generator]() this does not write anything. Several
+/// builders can therefore run on different documents in parallel and the
+/// partial inventories can be merged later.
+class inventory_builder : public model::visitor::recursive_visitor<true> {
   public:
-    inventory_generator(std::ostream& os);
+    /// Create a builder that adds entries to `inventory`.
+    explicit inventory_builder(inventory::sphinx::documentation_set& inventory);
 
     void visit(cpp_entity_documentation&) override;
     void visit(group_documentation&) override;
     void visit(document&) override;
 
-    ~inventory_generator() override;
-
   private:
     std::pair<std::string, std::string> domain_type(const cppast::cpp_entity& entity) const;
     int priority(const cppast::cpp_entity& entity) const;
     std::string display_name(const cppast::cpp_entity& entity) const;
     std::string name(const cppast::cpp_entity& entity) const;
 
-    inventory::sphinx::documentation_set inventory;
+    inventory::sphinx::documentation_set& inventory;
 
     std::string path;
 };
 
+/// Writes an intersphinx inventory for the documents it visits.
+/// The inventory is written when the generator is destroyed.
+class inventory_generator : public stream_generator {
+  public:
+    inventory_generator(std::ostream& os);
+
+    void visit(cpp_entity_documentation&) override;
+    void visit(group_documentation&) override;
+    void visit(document&) override;
+
+    ~inventory_generator() override;
+
+  private:
+    inventory::sphinx::documentation_set inventory;
+
+    inventory_builder builder;
+};
+
 }
 
 #endif
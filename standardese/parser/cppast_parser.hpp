@@ -10,6 +10,7 @@
 #include <cppast/forward.hpp>
 #include <cppast/libclang_parser.hpp>
 #include <boost/filesystem.hpp>
+#include <memory>
 
 #include "../threading/unthreaded_pool.hpp"
 #include "cpp_context.hpp"
@@ -30,6 +31,14 @@ class cppast_parser {
 
     /// Directory containing a `compile_commands.json` compilation database.
     type_safe::optional<boost::filesystem::path> compile_commands;
+
+    /// A header that is precompiled once for each distinct set of compiler
+    /// flags and then loaded into every source file before parsing.
+    /// Typically, this header includes the heavy headers that most sources
+    /// include, such as the standard library or Boost. Sources then do not
+    /// need to parse these headers again but skip them thanks to their
+    /// include guards.
+    type_safe::optional<boost::filesystem::path> prelude;
   };
 
   explicit cppast_parser(options);
@@ -39,11 +48,43 @@ class cppast_parser {
   /// \notes This operation is thread-safe.
   const cppast::cpp_file& parse(const boost::filesystem::path&);
 
+  /// Return the compiler flags that `source` is parsed with, not including
+  /// the flags that load the [options::prelude]().
+  std::vector<std::string> flags(const boost::filesystem::path& source) const;
+
+  /// Return all the files that are read when parsing `source`, i.e.,
+  /// `source` itself and all the headers it includes directly or
+  /// indirectly.
+  /// The files are determined by running the clang preprocessor on
+  /// `source`.
+  /// \throws An exception if the preprocessor fails.
+  /// \notes This operation is thread-safe.
+  std::vector<boost::filesystem::path> dependencies(const boost::filesystem::path& source) const;
+
+  /// Run the clang preprocessor on `source` with the flags it is parsed
+  /// with and write the result to `output`.
+  /// The output contains line markers for every file that the preprocessor
+  /// enters and leaves, the `#include` directives, and all macro
+  /// definitions.
+  /// \throws An exception if the preprocessor fails.
+  /// \notes This operation is thread-safe.
+  void preprocess(const boost::filesystem::path& source, const boost::filesystem::path& output) const;
+
   const cpp_context& context() const;
 
  private:
+  /// Return the configuration to parse `source` with.
+  cppast::libclang_compile_config config(const boost::filesystem::path& source) const;
+
+  /// Return `config` amended so that it loads the precompiled [options::prelude]().
+  cppast::libclang_compile_config with_prelude(cppast::libclang_compile_config config);
+
+  struct preludes;
+
   options options;
 
+  std::shared_ptr<preludes> preludes_;
+
   cpp_context context_;
 
   type_safe::optional<cppast::libclang_compilation_database> compile_commands;
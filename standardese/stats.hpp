@@ -0,0 +1,72 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_STATS_HPP_INCLUDED
+#define STANDARDESE_STATS_HPP_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace standardese::stats {
+
+/// Add `value` to the counter `name`.
+void count(const std::string& name, std::size_t value = 1);
+
+/// Add `bytes` to the memory used by `name`.
+void memory(const std::string& name, std::size_t bytes);
+
+/// Add `duration` to the time spent in `name`.
+void time(const std::string& name, std::chrono::nanoseconds duration);
+
+/// Adds the time between its construction and its destruction to the time
+/// spent in `name`.
+class timer {
+ public:
+  explicit timer(std::string name);
+  ~timer();
+
+  timer(const timer&) = delete;
+  timer& operator=(const timer&) = delete;
+
+ private:
+  std::string name;
+  std::chrono::steady_clock::time_point start;
+};
+
+/// A counter that is cheap enough to be incremented on hot paths.
+/// Unlike [count](), incrementing only performs a relaxed atomic addition.
+/// The total is added to the counter `name` when the statistics are
+/// reported.
+class counter {
+ public:
+  explicit counter(std::string name);
+  ~counter();
+
+  counter(const counter&) = delete;
+  counter& operator=(const counter&) = delete;
+
+  void operator++() noexcept { value.fetch_add(1, std::memory_order_relaxed); }
+
+  void operator+=(std::size_t delta) noexcept { value.fetch_add(delta, std::memory_order_relaxed); }
+
+ private:
+  friend void report(std::ostream&);
+  friend void reset();
+
+  std::string name;
+  std::atomic<std::size_t> value = 0;
+};
+
+/// Write all the statistics collected so far to `out`.
+void report(std::ostream& out);
+
+/// Forget all the statistics collected so far.
+void reset();
+
+}
+
+#endif
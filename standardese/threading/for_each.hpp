@@ -5,6 +5,9 @@
 #ifndef STANDARDESE_THREADING_FOR_EACH_HPP_INCLUDED
 #define STANDARDESE_THREADING_FOR_EACH_HPP_INCLUDED
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
 #include <vector>
 #include <fmt/format.h>
 
@@ -13,37 +16,74 @@
 
 namespace standardese::threading {
 
-/// Apply `f` to all the elements of the iterable.
-/// Any exceptions are logged but not rethrown.
-template <typename I, typename F>
-void for_each(pool::factory workers, I begin, I end, F f) {
-  std::vector<std::function<void()>> tasks;
-  
-  for (;begin != end; ++begin) {
-    tasks.emplace_back([begin, &f]() {
-      f(*begin);
-    });
-  }
+namespace detail {
 
-  std::vector<std::future<void>> futures;
+/// Split the range `[begin, end)` into consecutive chunks of at most `grain`
+/// elements and return the start of each chunk together with its size.
+/// If `grain` is zero, a grain size is picked so that every worker of
+/// `workers` gets a few chunks, which leaves some room for load balancing
+/// without paying the price of a task for every single element.
+template <typename I>
+std::vector<std::pair<I, std::size_t>> chunks(const pool& workers, I begin, I end, std::size_t grain) {
+  const std::size_t size = std::distance(begin, end);
 
-  {
-    auto pool = workers();
+  if (grain == 0) {
+    const std::size_t tasks = 4 * std::max(1u, workers.concurrency());
+    grain = std::max<std::size_t>(1, (size + tasks - 1) / tasks);
+  }
 
-    for (auto& task : tasks) futures.emplace_back(pool->enqueue(task));
+  std::vector<std::pair<I, std::size_t>> chunks;
+  chunks.reserve((size + grain - 1) / grain);
+
+  for (std::size_t remaining = size; remaining != 0;) {
+    const auto length = std::min(grain, remaining);
+    chunks.emplace_back(begin, length);
+    std::advance(begin, length);
+    remaining -= length;
   }
 
-  // Wait for all the workers to finish and report any exceptions that have
-  // happened in the workers.
-  for (auto it = futures.begin(); it != futures.end(); ++it) {
-    try {
-      it->get();
-    } catch (std::exception& e) {
-      logger::error(e.what());
-    }
+  return chunks;
+}
+
+}
+
+/// Apply `f` to all the elements of the iterable by running tasks in
+/// `workers`.
+/// Elements are processed in chunks of `grain` elements per task, see
+/// [detail::chunks]() for the default.
+/// This must not be called from a task that runs in `workers` itself since
+/// it blocks until all the tasks have completed.
+/// Any exceptions are logged but not rethrown.
+template <typename I, typename F>
+void for_each(pool& workers, I begin, I end, F f, std::size_t grain = 0) {
+  std::vector<std::future<void>> futures;
+
+  for (auto [chunk, length] : detail::chunks(workers, begin, end, grain)) {
+    futures.emplace_back(workers.enqueue([chunk=chunk, length=length, &f]() {
+      auto it = chunk;
+      for (std::size_t i = 0; i < length; ++i, ++it) {
+        try {
+          f(*it);
+        } catch (std::exception& e) {
+          logger::error(e.what());
+        }
+      }
+    }));
   }
+
+  // Wait for all the workers to finish.
+  for (auto& future : futures)
+    future.get();
 }
 
+/// Apply `f` to all the elements of the iterable in a pool that is created
+/// by `workers` and destroyed again once all tasks have completed.
+/// Any exceptions are logged but not rethrown.
+template <typename I, typename F>
+void for_each(pool::factory workers, I begin, I end, F f, std::size_t grain = 0) {
+  auto pool = workers();
+  for_each(*pool, begin, end, f, grain);
+}
 }
 
 #endif
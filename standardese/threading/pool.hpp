@@ -22,6 +22,10 @@ class pool {
   /// Run `task` in the worker pool.
   virtual std::future<void> enqueue(std::function<void()> task) = 0;
 
+  /// Return the number of tasks that this pool can run in parallel.
+  /// This is only a hint to decide how to split up work.
+  virtual unsigned concurrency() const;
+
   /// Wait for all tasks to finish and stop the worker pool.
   virtual ~pool();
 
@@ -21,6 +21,8 @@ class threaded_pool : public pool {
   threaded_pool(int parallelism);
 
   std::future<void> enqueue(std::function<void()> task) override;
+
+  unsigned concurrency() const override;
   
   /// Return a worker factory with the amount of parallelism.
   /// \param parallelism if non-positive, the value is selected automatically.
@@ -6,34 +6,55 @@
 #define STANDARDESE_THREADING_TRANSFORM_HPP_INCLUDED
 
 #include <vector>
-#include <optional>
-#include <cassert>
+#include <iterator>
 
 #include "for_each.hpp"
 
 namespace standardese::threading {
 
-/// Apply `f` to all the elements of the iterable and the return the results
-/// as a vector in the same order.
+/// Apply `f` to all the elements of the iterable by running tasks in
+/// `workers` and the return the results as a vector in the same order.
+/// Elements are processed in chunks of `grain` elements per task, see
+/// [detail::chunks]() for the default.
 /// Any exceptions are logged and the corresponding entries in the output
 /// vector are left default-initialized.
 template <typename I, typename F>
-auto transform(pool::factory workers, I begin, I end, F f) {
-  std::vector<decltype(f(*begin))> results;
-  std::vector<std::function<void()>> tasks;
-
-  for (int i = 0; begin != end; ++begin, i++) {
-    results.emplace_back();
-    tasks.emplace_back([begin, i, &f, &results]() {
-      results[i] = f(*begin);
-    });
+auto transform(pool& workers, I begin, I end, F f, std::size_t grain = 0) {
+  std::vector<decltype(f(*begin))> results(std::distance(begin, end));
+
+  std::vector<std::future<void>> futures;
+
+  std::size_t offset = 0;
+  for (auto [chunk, length] : detail::chunks(workers, begin, end, grain)) {
+    futures.emplace_back(workers.enqueue([chunk=chunk, length=length, offset, &f, &results]() {
+      auto it = chunk;
+      for (std::size_t i = 0; i < length; ++i, ++it) {
+        try {
+          results[offset + i] = f(*it);
+        } catch (std::exception& e) {
+          logger::error(e.what());
+        }
+      }
+    }));
+    offset += length;
   }
 
-  for_each(workers, tasks.begin(), tasks.end(), [](const auto& task) { task(); });
+  // Wait for all the workers to finish.
+  for (auto& future : futures)
+    future.get();
 
   return results;
 }
 
+/// Apply `f` to all the elements of the iterable in a pool that is created by
+/// `workers` and return the results as a vector in the same order.
+/// Any exceptions are logged and the corresponding entries in the output
+/// vector are left default-initialized.
+template <typename I, typename F>
+auto transform(pool::factory workers, I begin, I end, F f, std::size_t grain = 0) {
+  auto pool = workers();
+  return transform(*pool, begin, end, f, grain);
+}
 }
 
 #endif
@@ -0,0 +1,110 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_THREADING_WORK_STEALING_POOL_HPP_INCLUDED
+#define STANDARDESE_THREADING_WORK_STEALING_POOL_HPP_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pool.hpp"
+
+namespace standardese::threading {
+
+/// A multi-threaded worker pool where every worker has its own task queue.
+/// Unlike the [threaded_pool]() there is no single lock that every enqueue
+/// and dequeue has to go through. Each worker pushes and pops tasks at the
+/// bottom of its own deque without any locking and idle workers steal from
+/// the top of the other workers' deques with a single atomic operation.
+/// Tasks that are enqueued from outside of the pool go to a shared injection
+/// queue from which workers take tasks in batches.
+class work_stealing_pool : public pool {
+ public:
+  /// Create a worker pool with the amount of parallelism.
+  /// \param parallelism if non-positive, the value is selected automatically.
+  explicit work_stealing_pool(int parallelism);
+
+  std::future<void> enqueue(std::function<void()> task) override;
+
+  unsigned concurrency() const override;
+
+  /// Return a worker factory with the amount of parallelism.
+  /// \param parallelism if non-positive, the value is selected automatically.
+  static factory factory(int parallelism);
+
+  ~work_stealing_pool() override;
+
+ private:
+  using task = std::packaged_task<void()>;
+
+  /// A Chase-Lev deque of tasks, see "Dynamic Circular Work-Stealing Deque"
+  /// and "Correct and Efficient Work-Stealing for Weak Memory Models".
+  /// Only the owning worker may [push]() and [pop](), any thread may
+  /// [steal]().
+  class deque {
+   public:
+    deque();
+    ~deque();
+
+    void push(task*);
+    task* pop();
+    task* steal();
+
+    bool empty() const;
+
+   private:
+    struct buffer;
+
+    buffer* grow(buffer*, std::int64_t top, std::int64_t bottom);
+
+    std::atomic<std::int64_t> top;
+    std::atomic<std::int64_t> bottom;
+    std::atomic<buffer*> tasks;
+
+    /// Buffers that have been replaced by larger ones. They cannot be
+    /// released while the pool is running since a concurrent [steal]() might
+    /// still read from them.
+    std::vector<std::unique_ptr<buffer>> retired;
+  };
+
+  /// Run tasks until the pool is stopped.
+  void work(std::size_t worker);
+
+  /// Return a task for `worker` or nullptr if there is nothing to do.
+  task* next(std::size_t worker);
+
+  /// Move some tasks from the injection queue to the deque of `worker` and
+  /// return one of them.
+  task* take(std::size_t worker);
+
+  /// Wake up one sleeping worker if there is any.
+  void notify();
+
+  std::vector<std::unique_ptr<deque>> queues;
+  std::vector<std::thread> threads;
+
+  /// Tasks enqueued from outside of the pool.
+  std::deque<task*> injected;
+  std::mutex injected_mutex;
+
+  /// The number of tasks that have been enqueued but have not completed yet.
+  std::atomic<std::size_t> pending = 0;
+
+  std::atomic<bool> accepting = true;
+
+  std::atomic<int> sleeping = 0;
+  std::mutex sleep_mutex;
+  std::condition_variable task_enqueued;
+  std::condition_variable task_completed;
+};
+
+}
+
+#endif
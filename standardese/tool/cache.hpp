@@ -0,0 +1,69 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_TOOL_CACHE_HPP_INCLUDED
+#define STANDARDESE_TOOL_CACHE_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+
+#include "../forward.hpp"
+#include "../threading/pool.hpp"
+#include "parsers.hpp"
+
+namespace standardese::tool {
+
+/// Records the inputs and outputs of a run of the standardese executable so
+/// that a later run can be skipped if none of them changed.
+/// The record is a manifest of content hashes of the source files, the files
+/// they include directly or indirectly, any other files that affect the
+/// output such as configuration files, and the output files themselves. The
+/// manifest also records the version of standardese and the compiler flags
+/// of each source.
+class cache {
+ public:
+  struct options {
+    /// The directory where the manifest of the last run is kept.
+    /// If empty, no caching happens.
+    boost::filesystem::path directory;
+
+    /// Everything that affects the output but is not stored in a file,
+    /// typically the command line arguments.
+    std::string configuration;
+
+    /// Files besides the sources that affect the output, e.g., configuration
+    /// files or compilation databases.
+    std::vector<boost::filesystem::path> inputs;
+  };
+
+  explicit cache(struct options);
+
+  /// Return whether the outputs of the last recorded run are still up to
+  /// date, i.e., whether the version of standardese, the configuration, the
+  /// compiler flags of the sources of `parser`, and all the inputs and
+  /// outputs are unchanged.
+  bool up_to_date(const parsers::options& parser) const;
+
+  /// Return the inputs of this run, i.e., the sources of `parser`, all the
+  /// files they include, and the configured inputs.
+  /// The files included by the sources are determined by running the
+  /// preprocessor on each source by running tasks in `workers`.
+  /// Returns nothing if these files cannot be determined.
+  std::vector<boost::filesystem::path> inputs(const parsers::options& parser, threading::pool& workers) const;
+
+  /// Record the `inputs` and `outputs` of a successful run with `parser`.
+  /// Nothing is recorded if there are no `inputs`.
+  void record(const parsers::options& parser, const std::vector<boost::filesystem::path>& inputs, const std::vector<boost::filesystem::path>& outputs) const;
+
+  /// Return a hash of the contents of the file at `path`.
+  static std::string hash(const boost::filesystem::path& path);
+
+ private:
+  struct options options;
+};
+
+}
+
+#endif
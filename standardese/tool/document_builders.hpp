@@ -8,7 +8,9 @@
 
 #include <string>
 
+#include "../model/arena.hpp"
 #include "../model/unordered_entities.hpp"
+#include "../threading/pool.hpp"
 
 namespace standardese::tool {
 
@@ -36,6 +38,11 @@ class document_builders {
   /// Create the documents from the parsed source code.
   model::unordered_entities create(model::unordered_entities& parsed);
 
+  /// Create the documents from the parsed source code by running tasks in `workers`.
+  /// If `arenas` is set, each document is allocated in an arena of its own
+  /// that is taken from `arenas`.
+  model::unordered_entities create(model::unordered_entities& parsed, threading::pool& workers, model::arenas* arenas = nullptr);
+
  private:
   struct options options;
 };
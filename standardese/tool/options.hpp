@@ -12,6 +12,8 @@
 #include "parsers.hpp"
 #include "document_builders.hpp"
 #include "output_generators.hpp"
+#include "cache.hpp"
+#include "shards.hpp"
 
 namespace standardese::tool {
 
@@ -59,6 +61,23 @@ class options {
 
   /// Options that control how the output documents are emitted.
   struct tool::output_generators::options output_generator_options;
+
+  /// Options that control whether a run can be skipped because nothing
+  /// changed since the last run.
+  struct tool::cache::options cache_options;
+
+  /// Options that control which part of the sources this run processes and
+  /// whether the outputs of earlier runs should be merged instead.
+  struct tool::shards::options shard_options;
+
+  /// Whether to print statistics about the run, such as the time spent
+  /// building lookup tables and their sizes.
+  bool stats = false;
+
+  /// Whether to allocate the entities parsed from each source and each
+  /// output document in a [model::arena]() of its own that is only released
+  /// at the end of the run.
+  bool arena = false;
 };
 
 }
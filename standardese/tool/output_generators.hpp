@@ -7,10 +7,12 @@
 #define STANDARDESE_TOOL_OUTPUT_GENERATORS_HPP_INCLUDED
 
 #include <string>
+#include <vector>
 #include <boost/filesystem/path.hpp>
 
 #include "../model/unordered_entities.hpp"
 #include "../output_generator/markdown/markdown_generator.hpp"
+#include "../threading/pool.hpp"
 
 namespace standardese::tool {
 
@@ -54,8 +56,14 @@ class output_generators {
 
   output_generators(struct options);
 
-  /// Write the output files.
-  void emit(model::unordered_entities& documents);
+  /// Write the output files and return their paths.
+  /// Files whose content did not change are not written again.
+  std::vector<boost::filesystem::path> emit(model::unordered_entities& documents);
+
+  /// Write the output files by running tasks in `workers` and return their
+  /// paths.
+  /// Files whose content did not change are not written again.
+  std::vector<boost::filesystem::path> emit(model::unordered_entities& documents, threading::pool& workers);
 
  private:
   struct options options;
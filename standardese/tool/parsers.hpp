@@ -9,6 +9,8 @@
 #include "../parser/cppast_parser.hpp"
 #include "../parser/comment_collector.hpp"
 #include "../parser/comment_parser.hpp"
+#include "../model/arena.hpp"
+#include "../threading/pool.hpp"
 
 namespace standardese::tool {
 
@@ -28,13 +30,25 @@ class parsers {
 
     /// The number of worker threads to run in parallel.
     int parallelism = std::thread::hardware_concurrency() + 1;
+
+    /// Whether to generate a [parser::cppast_parser::options::prelude]()
+    /// from the system headers that more than one source includes before
+    /// anything else, unless a prelude has been configured explicitly.
+    bool shared_prelude = false;
   };
 
   parsers(struct options);
 
   /// Parse the source code and the comments and return a set of all the commented entities.
+  /// The parsing runs in a worker pool with the configured [parallelism]().
   std::pair<model::unordered_entities, parser::cpp_context> parse();
 
+  /// Parse the source code and the comments by running tasks in `workers`
+  /// and return a set of all the commented entities.
+  /// If `arenas` is set, the entities created from each source are
+  /// allocated in an arena of their own that is taken from `arenas`.
+  std::pair<model::unordered_entities, parser::cpp_context> parse(threading::pool& workers, model::arenas* arenas = nullptr);
+
  private:
   struct options options;
 };
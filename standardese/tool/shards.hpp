@@ -0,0 +1,57 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_TOOL_SHARDS_HPP_INCLUDED
+#define STANDARDESE_TOOL_SHARDS_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+
+namespace standardese::tool {
+
+/// Splits a run of the standardese executable into shards that can run
+/// independently, e.g., on separate machines, and merges their outputs.
+/// Each shard parses a deterministic subset of the sources and writes its
+/// documents and its `objects.inv` inventory to its own output directory.
+/// Links that cannot be resolved within a shard are written with the
+/// [deferred]() prefix. When merging, the inventories of all shards are
+/// combined and these deferred links are resolved against it.
+class shards {
+ public:
+  struct options {
+    /// The index of this shard, between 0 and [count]() - 1.
+    unsigned index = 0;
+
+    /// The total number of shards; no sharding happens if this is 1.
+    unsigned count = 1;
+
+    /// The output directories of the shards that should be merged.
+    /// If empty, nothing is merged.
+    std::vector<boost::filesystem::path> merge;
+  };
+
+  /// The URI prefix of the links that shards could not resolve themselves.
+  static const std::string deferred;
+
+  explicit shards(struct options);
+
+  /// Return the `sources` that this shard should parse.
+  /// Sources are assigned to shards by a hash of their path, so every shard
+  /// must be given the same paths, e.g., relative to the repository root.
+  std::vector<boost::filesystem::path> select(const std::vector<boost::filesystem::path>& sources) const;
+
+  /// Combine the outputs of the shards to merge into `output_directory`
+  /// and return the paths of the files written.
+  /// Links deferred by the shards are resolved with the combined inventory
+  /// of all shards.
+  std::vector<boost::filesystem::path> merge(const boost::filesystem::path& output_directory) const;
+
+ private:
+  struct options options;
+};
+
+}
+
+#endif
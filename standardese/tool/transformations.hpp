@@ -15,6 +15,8 @@
 #include "../transformation/link_target_external_transformation.hpp"
 #include "../transformation/link_external_legacy_transformation.hpp"
 #include "../transformation/link_sphinx_transformation.hpp"
+#include "../transformation/link_doxygen_transformation.hpp"
+#include "../transformation/link_target_unresolved_transformation.hpp"
 #include "../transformation/group_uncommented_transformation.hpp"
 #include "../transformation/group_transformation.hpp"
 #include "../transformation/entity_heading_transformation.hpp"
@@ -47,7 +49,7 @@ class transformations {
       /// The local path of the inventory file.
       boost::filesystem::path inventory;
 
-      struct transformation::link_sphinx_transformation::options options;
+      struct transformation::link_doxygen_transformation::options options;
     };
 
     struct external_legacy_options {
@@ -58,6 +60,14 @@ class transformations {
 
     /// How to establish links to external documentation.
     std::vector<external_link_option> external_link_options;
+
+    /// The directory where binary copies of the external inventories are
+    /// kept so that later runs do not need to parse them again.
+    /// If empty, external inventories are parsed on every run.
+    boost::filesystem::path inventory_cache;
+
+    /// What to do with links that could not be resolved.
+    struct transformation::link_target_unresolved_transformation::options unresolved_options;
   };
 
   transformations(options);
@@ -65,6 +75,9 @@ class transformations {
   /// Apply the configured transformations.
   void transform(model::unordered_entities& documents, const parser::cpp_context& context);
 
+  /// Apply the configured transformations by running tasks in `workers`.
+  void transform(model::unordered_entities& documents, const parser::cpp_context& context, threading::pool& workers);
+
  private:
   struct options options;
 };
@@ -6,6 +6,9 @@
 #ifndef STANDARDESE_TRANSFORMATION_ANCHOR_TRANSFORMATION_HPP_INCLUDED
 #define STANDARDESE_TRANSFORMATION_ANCHOR_TRANSFORMATION_HPP_INCLUDED
 
+#include <string>
+#include <string_view>
+
 #include "transformation.hpp"
 
 namespace standardese::transformation {
@@ -15,6 +18,12 @@ class anchor_transformation : public transformation {
   public:
     using transformation::transformation;
 
+    /// Return `text` turned into an identifier for an anchor like mkdocs does:
+    /// Characters other than letters, digits, `_`, whitespace and `-` are
+    /// dropped, everything is lowercased, and runs of whitespace and `-` are
+    /// replaced by a single `-`.
+    static std::string slug(std::string_view text);
+
   protected:
     void do_transform(model::entity& root) override;
 };
@@ -0,0 +1,48 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_TRANSFORMATION_LINK_DOXYGEN_TRANSFORMATION_HPP_INCLUDED
+#define STANDARDESE_TRANSFORMATION_LINK_DOXYGEN_TRANSFORMATION_HPP_INCLUDED
+
+#include <memory>
+#include <string>
+
+#include "link_target_external_transformation.hpp"
+#include "../inventory/doxygen/tagfile_index.hpp"
+#include "../inventory/doxygen/mapped_tagfile_index.hpp"
+#include "../inventory/symbols.hpp"
+
+namespace standardese::transformation
+{
+
+/// Resolves links to project documentations generated with Doxygen.
+class link_doxygen_transformation : public transformation {
+  public:
+    struct options : link_target_external_transformation::options {
+      /// The base URL of the external documentation.
+      std::string url;
+    };
+
+    link_doxygen_transformation(model::unordered_entities& documents, options options, inventory::doxygen::tagfile_index inventory);
+    link_doxygen_transformation(model::unordered_entities& documents, options options, std::shared_ptr<const inventory::doxygen::tagfile_index> inventory);
+    link_doxygen_transformation(model::unordered_entities& documents, options options, inventory::doxygen::mapped_tagfile_index inventory);
+
+    using transformation::transform;
+
+    void transform(model::entity& root) override;
+
+  protected:
+    void do_transform(model::entity&) override;
+
+  private:
+    link_doxygen_transformation(model::unordered_entities& documents, options options, std::shared_ptr<const inventory::inventory> inventory);
+
+    const options options;
+    const std::shared_ptr<const inventory::inventory> inventory;
+    link_target_external_transformation target_transformation;
+};
+
+}
+
+#endif
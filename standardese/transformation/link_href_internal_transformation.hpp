@@ -10,6 +10,7 @@
 
 #include "transformation.hpp"
 #include "../model/unordered_entities.hpp"
+#include "../model/interned_string.hpp"
 
 namespace standardese::transformation
 {
@@ -23,7 +24,8 @@ class link_href_internal_transformation : public transformation {
     void do_transform(model::entity&) override;
 
   private:
-    std::unordered_map<const cppast::cpp_entity*, std::string> anchors;
+    /// The URL of the anchor of each linkable C++ entity.
+    std::unordered_map<const cppast::cpp_entity*, model::interned_string> anchors;
 };
 
 }
@@ -5,8 +5,12 @@
 #ifndef STANDARDESE_TRANSFORMATION_LINK_SPHINX_TRANSFORMATION_HPP_INCLUDED
 #define STANDARDESE_TRANSFORMATION_LINK_SPHINX_TRANSFORMATION_HPP_INCLUDED
 
+#include <memory>
+#include <string>
+
 #include "link_target_external_transformation.hpp"
 #include "../inventory/sphinx/documentation_set.hpp"
+#include "../inventory/sphinx/mapped_documentation_set.hpp"
 #include "../inventory/symbols.hpp"
 
 namespace standardese::transformation
@@ -21,15 +25,23 @@ class link_sphinx_transformation : public transformation {
     };
 
     link_sphinx_transformation(model::unordered_entities& documents, options options, inventory::sphinx::documentation_set inventory);
+    link_sphinx_transformation(model::unordered_entities& documents, options options, inventory::sphinx::mapped_documentation_set inventory);
+
+    using transformation::transform;
 
-    void transform(threading::pool::factory workers=threading::unthreaded_pool::factory) override;
+    void transform(model::entity& root) override;
 
   protected:
     void do_transform(model::entity&) override;
 
   private:
+    link_sphinx_transformation(model::unordered_entities& documents, options options, std::shared_ptr<const inventory::sphinx::documentation_set> inventory);
+    link_sphinx_transformation(model::unordered_entities& documents, options options, std::shared_ptr<const inventory::inventory> inventory, std::string project, std::string version);
+
     const options options;
-    const inventory::sphinx::documentation_set inventory;
+    const std::shared_ptr<const inventory::inventory> inventory;
+    const std::string project;
+    const std::string version;
     link_target_external_transformation target_transformation;
 };
 
@@ -6,9 +6,14 @@
 #ifndef STANDARDESE_TRANSFORMATION_LINK_TARGET_INTERNAL_TRANSFORMATION_HPP_INCLUDED
 #define STANDARDESE_TRANSFORMATION_LINK_TARGET_INTERNAL_TRANSFORMATION_HPP_INCLUDED
 
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include "transformation.hpp"
 #include "../inventory/cppast_inventory.hpp"
 #include "../inventory/files.hpp"
+#include "../inventory/symbols.hpp"
 
 namespace standardese::transformation
 {
@@ -18,12 +23,27 @@ class link_target_internal_transformation : public transformation {
   public:
     link_target_internal_transformation(model::unordered_entities& documents, const parser::cpp_context& context);
 
+    ~link_target_internal_transformation();
+
+    /// Return whether `target` is an absolute URI with an authority such as
+    /// `https://example.com` or `standardese://name/`.
+    /// This is the case when `target` starts with a scheme, i.e., a non-empty
+    /// sequence of characters other than `:/?#`, followed by `://`. (As in
+    /// RFC 3986 p.50, but scheme and authority are not optional.)
+    static bool is_uri(std::string_view target);
+
   protected:
     void do_transform(model::entity&) override;
 
   private:
+    link_target_internal_transformation(model::unordered_entities& documents, const parser::cpp_context& context, std::pair<std::vector<const cppast::cpp_entity*>, std::vector<const cppast::cpp_file*>> documented);
+
     inventory::cppast_inventory inventory;
     inventory::files files;
+
+    // The symbols are shared by all the documents that are transformed
+    // concurrently. Lookups only populate their thread-safe index.
+    const inventory::symbols symbols;
 };
 
 }
@@ -6,6 +6,8 @@
 #ifndef STANDARDESE_TRANSFORMATION_LINK_TARGET_UNRESOLVED_TRANSFORMATION_HPP_INCLUDED
 #define STANDARDESE_TRANSFORMATION_LINK_TARGET_UNRESOLVED_TRANSFORMATION_HPP_INCLUDED
 
+#include <string>
+
 #include "transformation.hpp"
 #include "../forward.hpp"
 
@@ -16,10 +18,23 @@ namespace standardese::transformation
 /// resolved by other means, e.g., by emitting warnings for them.
 class link_target_unresolved_transformation : public transformation {
   public:
+    struct options {
+      /// If not empty, unresolved links are not reported but rewritten to
+      /// URIs consisting of this prefix followed by the link target, so that
+      /// they can be resolved later, e.g., when the outputs of several
+      /// [tool::shards]() are merged.
+      std::string defer;
+    };
+
     link_target_unresolved_transformation(model::unordered_entities& documents);
 
+    link_target_unresolved_transformation(model::unordered_entities& documents, options options);
+
   protected:
     void do_transform(model::entity&) override;
+
+  private:
+    const options options;
 };
 
 }
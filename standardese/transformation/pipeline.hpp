@@ -0,0 +1,78 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_TRANSFORMATION_PIPELINE_HPP_INCLUDED
+#define STANDARDESE_TRANSFORMATION_PIPELINE_HPP_INCLUDED
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "transformation.hpp"
+
+namespace standardese::transformation {
+
+/// Applies a sequence of transformations to a set of documents in parallel.
+/// Each document runs through the transformations in the order in which
+/// they have been added. Documents do not wait for each other, i.e., links
+/// in one document might get resolved while another document is already
+/// having its synopsis generated.
+/// A transformation that needs to see the effect of the earlier
+/// transformations on all the documents has to declare this with
+/// [dependency::all_documents]().
+class pipeline {
+  public:
+    /// What a transformation requires to have happened before it can run
+    /// on a document.
+    enum class dependency {
+      /// All the earlier transformations must have been applied to this
+      /// document.
+      document,
+      /// All the earlier transformations must have been applied to all the
+      /// documents. For example, because the transformation collects
+      /// information from all documents when it is created.
+      all_documents,
+    };
+
+    explicit pipeline(model::unordered_entities& documents);
+
+    /// Add a transformation of type `T` to the end of the pipeline.
+    /// The transformation is only created once its `dependency` has been
+    /// satisfied, by passing the documents and `args` to its constructor.
+    /// The `args` are moved into the transformation, i.e., they are not
+    /// copied if they are passed as rvalues.
+    template <typename T, typename ...Args>
+    void emplace(dependency dependency, Args&&... args) {
+      auto arguments = std::make_shared<std::tuple<std::decay_t<Args>...>>(std::forward<Args>(args)...);
+      add(dependency, [arguments](model::unordered_entities& documents) -> std::unique_ptr<transformation> {
+        // Each transformation is created only once so we can hand the
+        // arguments over to it.
+        return std::apply([&](auto&... args) {
+          return std::make_unique<T>(documents, std::move(args)...);
+        }, *arguments);
+      });
+    }
+
+    /// Add a transformation to the end of the pipeline that is created by
+    /// `create` once its `dependency` has been satisfied.
+    void add(dependency dependency, std::function<std::unique_ptr<transformation>(model::unordered_entities&)> create);
+
+    /// Apply all the transformations by running tasks in `workers`.
+    void transform(threading::pool& workers);
+
+  private:
+    /// Transformations that can be applied to each document without waiting
+    /// for the other documents.
+    using stage = std::vector<std::function<std::unique_ptr<transformation>(model::unordered_entities&)>>;
+
+    std::vector<stage> stages;
+
+    model::unordered_entities& documents;
+};
+
+}
+
+#endif
@@ -16,7 +16,18 @@ class transformation {
   public:
     explicit transformation(model::unordered_entities& entities);
 
-    virtual void transform(threading::pool::factory workers=threading::unthreaded_pool::factory);
+    virtual ~transformation() = default;
+
+    /// Apply this transformation to all entities in a worker pool created by `workers`.
+    void transform(threading::pool::factory workers=threading::unthreaded_pool::factory);
+
+    /// Apply this transformation to all entities by running tasks in `workers`.
+    void transform(threading::pool& workers);
+
+    /// Apply this transformation to a single one of the entities.
+    /// This is what [transform]() runs for each entity. A [pipeline]() uses
+    /// it to run several transformations on an entity one after the other.
+    virtual void transform(model::entity& root);
 
   protected:
     virtual void do_transform(model::entity& root) = 0;
@@ -2,6 +2,8 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <sstream>
+#include <vector>
 #include <cppast/cpp_entity_kind.hpp>
 
 #include "../../external/catch/single_include/catch2/catch.hpp"
@@ -11,6 +13,7 @@
 
 #include "../../standardese/inventory/cppast_inventory.hpp"
 #include "../../standardese/inventory/symbols.hpp"
+#include "../../standardese/stats.hpp"
 
 namespace standardese::test::inventory
 {
@@ -313,4 +316,123 @@ TEST_CASE("Type Lookup in MarkDown Links", "[cppast_inventory]") {
     }
 }
 
+
+TEST_CASE("Relative Lookups are Cached", "[cppast_inventory]")
+{
+    auto logger = util::logger::throwing_logger();
+
+    const util::cpp_file header(R"(
+        struct X {
+            using size_type = unsigned;
+
+            void f(size_type arg);
+            void g(size_type arg);
+        };
+        )");
+
+    // Return the hits and misses of the lookup cache when looking up the
+    // same names `iterations` times.
+    const auto lookup = [&](int iterations) {
+        stats::reset();
+        {
+            cppast_inventory inventory({header}, header);
+            symbols symbols{inventory};
+
+            for (int i = 0; i < iterations; i++) {
+                CHECK(symbols.find("size_type", header["X::f"]));
+                CHECK(symbols.find("size_type", header["X::g"]));
+                CHECK(!symbols.find("value_type", header["X::f"]));
+                CHECK(!symbols.find("value_type", header["X::g"]));
+            }
+        }
+
+        std::stringstream report;
+        stats::report(report);
+
+        const auto count = [&](const std::string& name) -> std::size_t {
+            std::istringstream lines(report.str());
+            for (std::string line; std::getline(lines, line);)
+                if (line.compare(0, name.size(), name) == 0)
+                    return std::stoul(line.substr(name.size()));
+            return 0;
+        };
+
+        return std::make_pair(count("link inventory: relative lookup cache hits"), count("link inventory: relative lookup cache misses"));
+    };
+
+    // The first iteration misses in every scope that it walks through: in f
+    // and X for size_type which is found in X, in g and then hits in X, in
+    // f, X, and the file for value_type which is not found anywhere, and in
+    // g and then hits in X again.
+    CHECK(lookup(1) == std::make_pair(std::size_t{2}, std::size_t{7}));
+
+    // The second iteration finds everything in the cache right away.
+    CHECK(lookup(2) == std::make_pair(std::size_t{6}, std::size_t{7}));
+}
+
+
+TEST_CASE("Batch Lookups", "[cppast_inventory]")
+{
+    auto logger = util::logger::throwing_logger();
+
+    const util::cpp_file header(R"(
+        namespace a {
+            namespace b {
+                void f();
+            }
+
+            struct X {
+                void g(int arg);
+            };
+        }
+
+        namespace b {
+            void f(int);
+            void h();
+        }
+        )");
+
+    cppast_inventory inventory({header}, header);
+    symbols symbols{inventory};
+
+    const auto target =[](const auto& anchor) {
+      return anchor.value().accept([&](auto&& target) -> type_safe::object_ref<const cppast::cpp_entity> {
+        using T = std::decay_t<decltype(target)>;
+        if constexpr (std::is_same_v<T, model::link_target::cppast_target>) {
+          return target.target;
+        } else {
+          throw std::logic_error("name did not resolve to a cppast entity");
+        }
+      });
+    };
+
+    std::vector<symbols::lookup> lookups{
+      {"b::f", header["a"]},
+      {"b::f(int)", header["a"]},
+      {"b::h", header["a"]},
+      {"b::f", header["a::X"]},
+      {"b::f"},
+      {"::b::f", header["a"]},
+      {"X::g.arg", header["a"]},
+      {"X::g.brg", header["a"]},
+      {"b::f", static_cast<const cppast::cpp_entity&>(header)},
+      {"b::f", header["a"]},
+      {"", header["a"]},
+    };
+
+    symbols.find(lookups);
+
+    CHECK(target(lookups[0].target) == target(symbols.find("::a::b::f")));
+    CHECK(target(lookups[1].target) == target(symbols.find("::b::f")));
+    CHECK(target(lookups[2].target) == target(symbols.find("::b::h")));
+    CHECK(target(lookups[3].target) == target(symbols.find("::a::b::f")));
+    CHECK(target(lookups[4].target) == target(symbols.find("::b::f")));
+    CHECK(target(lookups[5].target) == target(symbols.find("::b::f")));
+    CHECK(target(lookups[6].target) == target(symbols.find("::a::X::g.arg")));
+    CHECK(!lookups[7].target);
+    CHECK(target(lookups[8].target) == target(symbols.find("::b::f")));
+    CHECK(target(lookups[9].target) == target(lookups[0].target));
+    CHECK(!lookups[10].target);
+}
+
 }
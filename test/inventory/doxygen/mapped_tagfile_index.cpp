@@ -0,0 +1,107 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <boost/filesystem/operations.hpp>
+
+#include "../../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../../util/logger.hpp"
+
+#include "../../../standardese/inventory/doxygen/tagfile_index.hpp"
+#include "../../../standardese/inventory/doxygen/mapped_tagfile_index.hpp"
+#include "../../../standardese/inventory/symbols.hpp"
+
+using standardese::inventory::doxygen::tagfile_index;
+using standardese::inventory::doxygen::mapped_tagfile_index;
+using standardese::inventory::symbols;
+
+namespace standardese::test::inventory::doxygen {
+
+TEST_CASE("Binary Copies of Doxygen Tagfile Indexes", "[tagfile]") {
+    auto logger = util::logger::throwing_logger();
+
+    tagfile_index index;
+    index.add("ns::vector", "classns_1_1vector.html", "");
+    index.add("ns::vector::push_back", "classns_1_1vector.html", "a1b2c3");
+    index.add("ns::color::red", "namespacens.html", "a7b8");
+    index.add("ns::red", "namespacens.html", "a7b8");
+
+    const auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("standardese-%%%%-%%%%.tag");
+
+    mapped_tagfile_index::write(path, index, "0123456789abcdef");
+
+    SECTION("A Binary Copy is Rejected for Different Contents") {
+      CHECK(!mapped_tagfile_index::open(path, "fedcba9876543210"));
+    }
+
+    SECTION("A Binary Copy Resolves Like the Original Index") {
+      const auto mapped = mapped_tagfile_index::open(path, "0123456789abcdef");
+      REQUIRE(mapped);
+
+      CHECK(mapped.value().size() == index.size());
+
+      symbols symbols{mapped.value()};
+
+      const auto location = [&](const std::string& name) -> std::string {
+        const auto target = symbols.find(name);
+        if (!target)
+          return "";
+        return target.value().accept([](auto&& target) -> std::string {
+          using T = std::decay_t<decltype(target)>;
+          if constexpr (std::is_same_v<T, model::link_target::doxygen_target>) {
+            return target.filename + "#" + target.anchor;
+          } else {
+            return "?";
+          }
+        });
+      };
+
+      CHECK(location("ns::vector") == "classns_1_1vector.html#");
+      CHECK(location("ns::vector::push_back") == "classns_1_1vector.html#a1b2c3");
+      CHECK(location("ns::red") == "namespacens.html#a7b8");
+      CHECK(location("vector") == "");
+    }
+
+    boost::filesystem::remove(path);
+}
+
+TEST_CASE("Corrupt Binary Copies of Doxygen Tagfile Indexes are Rejected", "[tagfile]") {
+    std::stringstream logstream;
+    auto logger = util::logger::capturing_logger(logstream);
+
+    tagfile_index index;
+    index.add("ns::vector", "classns_1_1vector.html", "");
+
+    const auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("standardese-%%%%-%%%%.tag");
+
+    mapped_tagfile_index::write(path, index, "0123456789abcdef");
+    REQUIRE(mapped_tagfile_index::open(path, "0123456789abcdef"));
+
+    // Overwrite 32 bits of the binary index at `position`.
+    const auto corrupt = [&](std::streamoff position, std::uint32_t value) {
+      std::fstream file(path.native(), std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(position);
+      file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    // The header takes 52 bytes, the single record another 24 bytes.
+    SECTION("Strings Must be in the String Table") {
+      corrupt(52, 0xfffffff0);
+      CHECK(!mapped_tagfile_index::open(path, "0123456789abcdef"));
+      CHECK(logstream.str().find("corrupt") != std::string::npos);
+    }
+
+    SECTION("The Hash Index Must Refer to Existing Records") {
+      corrupt(52 + 24, 2);
+      CHECK(!mapped_tagfile_index::open(path, "0123456789abcdef"));
+      CHECK(logstream.str().find("corrupt") != std::string::npos);
+    }
+
+    boost::filesystem::remove(path);
+}
+
+}
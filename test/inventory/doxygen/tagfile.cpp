@@ -0,0 +1,154 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <sstream>
+
+#include "../../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../../util/logger.hpp"
+
+#include "../../../standardese/inventory/doxygen/tagfile.hpp"
+#include "../../../standardese/inventory/doxygen/tagfile_index.hpp"
+#include "../../../standardese/inventory/symbols.hpp"
+
+using standardese::inventory::doxygen::tagfile;
+using standardese::inventory::doxygen::tagfile_index;
+using standardese::inventory::symbols;
+
+namespace standardese::test::inventory::doxygen {
+
+namespace {
+
+const char* xml = R"(<?xml version='1.0' encoding='UTF-8' standalone='yes' ?>
+<tagfile doxygen_version="1.9.1">
+  <compound kind="class">
+    <name>ns::vector</name>
+    <filename>classns_1_1vector.html</filename>
+    <templarg>typename T</templarg>
+    <member kind="function">
+      <type>void</type>
+      <name>push_back</name>
+      <anchorfile>classns_1_1vector.html</anchorfile>
+      <anchor>a1b2c3</anchor>
+      <arglist>(const T &amp;value)</arglist>
+    </member>
+    <docanchor file="classns_1_1vector.html" title="Complexity">complexity</docanchor>
+  </compound>
+  <compound kind="namespace">
+    <name>ns</name>
+    <filename>namespacens.html</filename>
+    <class kind="class">ns::vector</class>
+    <member kind="enumeration">
+      <type></type>
+      <name>color</name>
+      <anchorfile>namespacens.html</anchorfile>
+      <anchor>d4e5f6</anchor>
+      <arglist></arglist>
+      <enumvalue file="namespacens.html" anchor="a7b8">red</enumvalue>
+    </member>
+  </compound>
+  <compound kind="file">
+    <name>vector.hpp</name>
+    <path>/include/</path>
+    <filename>vector_8hpp.html</filename>
+    <member kind="define">
+      <type></type>
+      <name>NS_VERSION</name>
+      <anchorfile>vector_8hpp.html</anchorfile>
+      <anchor>c9d0</anchor>
+      <arglist></arglist>
+    </member>
+  </compound>
+  <compound kind="page">
+    <name>index</name>
+    <title>Overview</title>
+    <filename>index.html</filename>
+  </compound>
+</tagfile>
+)";
+
+}
+
+TEST_CASE("Loading a Doxygen Tagfile", "[tagfile]") {
+    tagfile inventory;
+    std::istringstream(xml) >> inventory;
+
+    REQUIRE(inventory.types.size() == 1);
+    CHECK(inventory.types[0].kind == "class");
+    CHECK(inventory.types[0].name == "ns::vector");
+    CHECK(inventory.types[0].template_args == std::vector<std::string>{"typename T"});
+    CHECK(inventory.types[0].anchors.size() == 1);
+    CHECK(inventory.types[0].anchors[0].title == "Complexity");
+
+    REQUIRE(inventory.types[0].members.size() == 1);
+    CHECK(inventory.types[0].members[0].args == "(const T &value)");
+
+    REQUIRE(inventory.namespaces.size() == 1);
+    CHECK(inventory.namespaces[0].members[0].enum_values[0].name == "red");
+
+    REQUIRE(inventory.files.size() == 1);
+    CHECK(inventory.files[0].path == "/include/");
+
+    REQUIRE(inventory.pages.size() == 1);
+    CHECK(inventory.pages[0].title == "Overview");
+}
+
+TEST_CASE("Indexing a Doxygen Tagfile", "[tagfile]") {
+    tagfile_index index;
+    std::istringstream(xml) >> index;
+
+    // Compounds, members, and enum values with and without the name of
+    // their enum but no pages.
+    CHECK(index.size() == 8);
+
+    REQUIRE(index.find("ns::vector::push_back"));
+    CHECK(index.find("ns::vector::push_back").value().filename == "classns_1_1vector.html");
+    CHECK(index.find("ns::vector::push_back").value().anchor == "a1b2c3");
+
+    CHECK(!index.find("index"));
+    CHECK(!index.find("complexity"));
+}
+
+TEST_CASE("Lookup of Names in Doxygen Tagfiles", "[tagfile]") {
+    auto logger = util::logger::throwing_logger();
+
+    tagfile_index inventory;
+    std::istringstream(xml) >> inventory;
+
+    symbols symbols{inventory};
+
+    const auto location = [&](const std::string& name) -> std::string {
+      const auto target = symbols.find(name);
+      if (!target)
+        return "";
+      return target.value().accept([](auto&& target) -> std::string {
+        using T = std::decay_t<decltype(target)>;
+        if constexpr (std::is_same_v<T, model::link_target::doxygen_target>) {
+          return target.filename + "#" + target.anchor;
+        } else {
+          return "?";
+        }
+      });
+    };
+
+    SECTION("Compounds are Found by their Fully Qualified Name") {
+      CHECK(location("ns::vector") == "classns_1_1vector.html#");
+      CHECK(location("::ns") == "namespacens.html#");
+      CHECK(location("vector.hpp") == "vector_8hpp.html#");
+    }
+
+    SECTION("Members are Found by their Fully Qualified Name") {
+      CHECK(location("ns::vector::push_back") == "classns_1_1vector.html#a1b2c3");
+      CHECK(location("ns::color") == "namespacens.html#d4e5f6");
+      CHECK(location("ns::color::red") == "namespacens.html#a7b8");
+      CHECK(location("ns::red") == "namespacens.html#a7b8");
+      CHECK(location("NS_VERSION") == "vector_8hpp.html#c9d0");
+    }
+
+    SECTION("Pages are not C++ Entities") {
+      CHECK(location("index") == "");
+    }
+}
+
+}
@@ -0,0 +1,66 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <boost/filesystem/path.hpp>
+#include <cppast/cpp_file.hpp>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../util/cpp_file.hpp"
+#include "../util/logger.hpp"
+
+#include "../../standardese/inventory/files.hpp"
+
+namespace standardese::test::inventory
+{
+
+using standardese::inventory::files;
+
+TEST_CASE("Header Lookup in MarkDown Links", "[files]")
+{
+    auto logger = util::logger::throwing_logger();
+
+    const util::cpp_file first("", "first.hpp");
+    const util::cpp_file second("", "second.hpp");
+
+    const cppast::cpp_file* a = first;
+    const cppast::cpp_file* b = second;
+    const auto path = boost::filesystem::path(a->name());
+
+    files inventory({a, b});
+
+    const auto find = [&](const std::string& name, const cppast::cpp_entity* entity) -> const cppast::cpp_file* {
+      const auto header = inventory.find_header(name, *entity);
+      return header ? &header.value() : nullptr;
+    };
+
+    SECTION("Headers are Found by their File Name")
+    {
+        CHECK(find("first.hpp", b) == a);
+        CHECK(find("second.hpp", a) == b);
+    }
+
+    SECTION("Headers are Found by their Absolute Path")
+    {
+        CHECK(find(path.generic_string(), b) == a);
+    }
+
+    SECTION("Headers are Found Relative to the Entity")
+    {
+        CHECK(find("./first.hpp", a) == a);
+        CHECK(find("../" + path.parent_path().filename().generic_string() + "/first.hpp", b) == a);
+    }
+
+    SECTION("Headers are Found by a Trailing Part of their Path")
+    {
+        CHECK(find(path.parent_path().filename().generic_string() + "/first.hpp", b) == a);
+    }
+
+    SECTION("Unknown Headers are not Found")
+    {
+        CHECK(find("third.hpp", a) == nullptr);
+    }
+}
+
+}
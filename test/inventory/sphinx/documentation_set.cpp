@@ -3,8 +3,13 @@
 // found in the top-level directory of this distribution.
 
 #include <fstream>
+#include <sstream>
+#include <string>
 
 #include <boost/filesystem/path.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
 
 #include "../../../external/catch/single_include/catch2/catch.hpp"
 
@@ -50,6 +55,88 @@ TEST_CASE("Loading an Intersphinx Inventory", "[documentation_set]") {
     }
 }
 
+TEST_CASE("Lines of an Intersphinx Inventory are Split like Sphinx Does", "[documentation_set]") {
+    // Return the entries of an inventory whose compressed part is `lines`.
+    const auto load = [](const std::string& lines) {
+      std::stringstream inventory;
+      inventory << "# Sphinx inventory version 2\n# Project: test\n# Version: 1.0\n# The remainder of this file is compressed using zlib.\n";
+
+      {
+        boost::iostreams::filtering_streambuf<boost::iostreams::output> compressed;
+        compressed.push(boost::iostreams::zlib_compressor());
+        compressed.push(inventory);
+
+        std::stringstream uncompressed(lines);
+        boost::iostreams::copy(uncompressed, compressed);
+      }
+
+      documentation_set set;
+      inventory >> set;
+      CHECK(set.project == "test");
+      return set.entries;
+    };
+
+    SECTION("Names can Contain Spaces") {
+      const auto entries = load("a name  with spaces std:label -1 page.html#anchor A Name\n");
+
+      REQUIRE(entries.size() == 1);
+      CHECK(entries[0].name == "a name  with spaces");
+      CHECK(entries[0].domain == "std");
+      CHECK(entries[0].type == "label");
+      CHECK(entries[0].priority == -1);
+      CHECK(entries[0].uri == "page.html#anchor");
+      CHECK(entries[0].display_name == "A Name");
+    }
+
+    SECTION("Locations can be Empty") {
+      const auto entries = load("index std:doc 1  Index\n");
+
+      REQUIRE(entries.size() == 1);
+      CHECK(entries[0].name == "index");
+      CHECK(entries[0].uri == "");
+      CHECK(entries[0].display_name == "Index");
+    }
+
+    SECTION("A Trailing $ in the Location is Replaced with the Name") {
+      const auto entries = load("abc.ABC py:class 1 library/abc.html#$ -\n");
+
+      REQUIRE(entries.size() == 1);
+      CHECK(entries[0].uri == "library/abc.html#abc.ABC");
+      CHECK(entries[0].display_name == "-");
+    }
+
+    SECTION("Lines can End in CRLF") {
+      const auto entries = load("first py:function 1 first.html First\r\nsecond py:function 1 second.html -\r\n");
+
+      REQUIRE(entries.size() == 2);
+      CHECK(entries[0].name == "first");
+      CHECK(entries[0].display_name == "First");
+      CHECK(entries[1].name == "second");
+      CHECK(entries[1].uri == "second.html");
+      CHECK(entries[1].display_name == "-");
+    }
+
+    SECTION("Lines can Span Several Inflated Chunks") {
+      // The second line starts shortly before the end of the first 64 KiB
+      // that are inflated and ends after it.
+      const std::string first = "padding py:function 1 padding.html " + std::string((1 << 16) - 40, 'x') + "\n";
+      const auto entries = load(first + "split.name py:function 1 split.html Split Name\n");
+
+      REQUIRE(entries.size() == 2);
+      CHECK(entries[0].display_name == std::string((1 << 16) - 40, 'x'));
+      CHECK(entries[1].name == "split.name");
+      CHECK(entries[1].uri == "split.html");
+      CHECK(entries[1].display_name == "Split Name");
+    }
+
+    SECTION("Malformed Lines are Ignored") {
+      const auto entries = load("no-priority py:function here.html -\nok py:function 1 ok.html -\n");
+
+      REQUIRE(entries.size() == 1);
+      CHECK(entries[0].name == "ok");
+    }
+}
+
 TEST_CASE("Type Lookup up in Intersphinx Documentation Sets", "[documentation_set]") {
     auto logger = util::logger::throwing_logger();
 
@@ -64,4 +151,44 @@ TEST_CASE("Type Lookup up in Intersphinx Documentation Sets", "[documentation_se
     }
 }
 
+TEST_CASE("Lookup of Qualified Names in Intersphinx Documentation Sets", "[documentation_set]") {
+    auto logger = util::logger::throwing_logger();
+
+    documentation_set inventory;
+    inventory.entries.emplace_back("std::vector", "cpp", "class", 1, "vector", "std::vector");
+    inventory.entries.emplace_back("std::vector::push_back", "cpp", "function", 1, "vector/push_back", "std::vector::push_back");
+    inventory.entries.emplace_back("std::deque::push_back", "cpp", "function", 1, "deque/push_back", "std::deque::push_back");
+    inventory.entries.emplace_back("std::vector", "cpp", "class", 0, "container/vector", "std::vector");
+    inventory.entries.emplace_back("detail::vector", "cpp", "class", 2, "detail/vector", "detail::vector");
+
+    symbols symbols{inventory};
+
+    const auto uri = [&](const std::string& name) -> std::string {
+      const auto target = symbols.find(name);
+      if (!target)
+        return "";
+      return target.value().accept([](auto&& target) -> std::string {
+        using T = std::decay_t<decltype(target)>;
+        if constexpr (std::is_same_v<T, model::link_target::sphinx_target>) {
+          return target.entry.uri;
+        } else {
+          return "?";
+        }
+      });
+    };
+
+    SECTION("The Entry with the Best Priority is Found") {
+      CHECK(uri("std::vector") == "container/vector");
+    }
+
+    SECTION("Entries can be Found by their Partially Qualified Name") {
+      CHECK(uri("vector::push_back") == "vector/push_back");
+      CHECK(uri("vector") == "container/vector");
+    }
+
+    SECTION("Ambiguous Partially Qualified Names are not Resolved") {
+      CHECK(uri("push_back") == "");
+    }
+}
+
 }
@@ -0,0 +1,113 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <boost/filesystem/operations.hpp>
+
+#include "../../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../../util/logger.hpp"
+
+#include "../../../standardese/inventory/sphinx/documentation_set.hpp"
+#include "../../../standardese/inventory/sphinx/mapped_documentation_set.hpp"
+#include "../../../standardese/inventory/symbols.hpp"
+
+using standardese::inventory::sphinx::documentation_set;
+using standardese::inventory::sphinx::mapped_documentation_set;
+using standardese::inventory::symbols;
+
+namespace standardese::test::inventory::sphinx {
+
+TEST_CASE("Binary Copies of Intersphinx Documentation Sets", "[documentation_set]") {
+    auto logger = util::logger::throwing_logger();
+
+    documentation_set inventory;
+    inventory.project = "C++";
+    inventory.version = "17";
+    inventory.entries.emplace_back("std::vector", "cpp", "class", 1, "vector", "std::vector");
+    inventory.entries.emplace_back("std::vector::push_back", "cpp", "function", 1, "vector/push_back", "std::vector::push_back");
+    inventory.entries.emplace_back("std::deque::push_back", "cpp", "function", 1, "deque/push_back", "std::deque::push_back");
+    inventory.entries.emplace_back("std::vector", "cpp", "class", 0, "container/vector", "std::vector");
+    inventory.entries.emplace_back("detail::vector", "cpp", "class", 2, "detail/vector", "detail::vector");
+
+    const auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("standardese-%%%%-%%%%.inv");
+
+    mapped_documentation_set::write(path, inventory, "0123456789abcdef");
+
+    SECTION("A Binary Copy is Rejected for Different Contents") {
+      CHECK(!mapped_documentation_set::open(path, "fedcba9876543210"));
+    }
+
+    SECTION("A Binary Copy Resolves Like the Original Inventory") {
+      const auto mapped = mapped_documentation_set::open(path, "0123456789abcdef");
+      REQUIRE(mapped);
+
+      CHECK(mapped.value().project() == "C++");
+      CHECK(mapped.value().version() == "17");
+      CHECK(mapped.value().size() == inventory.entries.size());
+
+      symbols symbols{mapped.value()};
+
+      const auto uri = [&](const std::string& name) -> std::string {
+        const auto target = symbols.find(name);
+        if (!target)
+          return "";
+        return target.value().accept([](auto&& target) -> std::string {
+          using T = std::decay_t<decltype(target)>;
+          if constexpr (std::is_same_v<T, model::link_target::sphinx_target>) {
+            return target.entry.uri;
+          } else {
+            return "?";
+          }
+        });
+      };
+
+      CHECK(uri("std::vector") == "container/vector");
+      CHECK(uri("vector::push_back") == "vector/push_back");
+      CHECK(uri("vector") == "container/vector");
+      CHECK(uri("push_back") == "");
+      CHECK(uri("list") == "");
+    }
+
+    boost::filesystem::remove(path);
+}
+
+TEST_CASE("Corrupt Binary Copies of Intersphinx Documentation Sets are Rejected", "[documentation_set]") {
+    std::stringstream logstream;
+    auto logger = util::logger::capturing_logger(logstream);
+
+    documentation_set inventory;
+    inventory.entries.emplace_back("std::vector", "cpp", "class", 1, "vector", "std::vector");
+
+    const auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("standardese-%%%%-%%%%.inv");
+
+    mapped_documentation_set::write(path, inventory, "0123456789abcdef");
+    REQUIRE(mapped_documentation_set::open(path, "0123456789abcdef"));
+
+    // Overwrite 32 bits of the binary inventory at `position`.
+    const auto corrupt = [&](std::streamoff position, std::uint32_t value) {
+      std::fstream file(path.native(), std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(position);
+      file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    // The header takes 72 bytes, the single record another 48 bytes.
+    SECTION("Strings Must be in the String Table") {
+      corrupt(72, 0xfffffff0);
+      CHECK(!mapped_documentation_set::open(path, "0123456789abcdef"));
+      CHECK(logstream.str().find("corrupt") != std::string::npos);
+    }
+
+    SECTION("Hash Indexes Must Refer to Existing Records") {
+      corrupt(72 + 48, 2);
+      CHECK(!mapped_documentation_set::open(path, "0123456789abcdef"));
+      CHECK(logstream.str().find("corrupt") != std::string::npos);
+    }
+
+    boost::filesystem::remove(path);
+}
+
+}
@@ -0,0 +1,169 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <memory_resource>
+#include <thread>
+#include <type_safe/optional.hpp>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../../standardese/model/arena.hpp"
+#include "../../standardese/model/entity.hpp"
+#include "../../standardese/model/markup/paragraph.hpp"
+#include "../../standardese/model/markup/emphasis.hpp"
+#include "../../standardese/model/visitor/visit.hpp"
+
+namespace standardese::test::model {
+
+using standardese::model::arena;
+using standardese::model::entity;
+using standardese::model::markup::paragraph;
+using standardese::model::markup::emphasis;
+using standardese::model::markup::text;
+using standardese::model::visitor::visit;
+
+TEST_CASE("Entities can be Allocated in an Arena", "[arena]") {
+  arena arena;
+
+  const auto count = [](const entity& root) {
+    int entities = 0;
+    visit([&](auto&&, auto&& recurse) {
+      entities++;
+      recurse();
+    }, root);
+    return entities;
+  };
+
+  SECTION("Entities are Allocated in the Active Arena") {
+    arena::scope scope{arena};
+
+    CHECK(arena::active() == &arena);
+    CHECK(arena::resource() == &arena);
+
+    entity root = paragraph{
+      text("some text"),
+      emphasis(text("some emphasized text")),
+    };
+
+    CHECK(arena.memory() > 0);
+
+    entity copy = root.clone();
+    copy.as<paragraph>().add_child(text("more text"));
+
+    CHECK(count(root) == 4);
+    CHECK(count(copy) == 5);
+  }
+
+  SECTION("The Memory of an Arena is the Size of its Slabs") {
+    arena::scope scope{arena};
+
+    entity root = paragraph{};
+
+    // The first slab is much larger than a paragraph with one more child.
+    const auto allocated = arena.memory();
+    root.as<paragraph>().add_child(text("some text"));
+    CHECK(arena.memory() == allocated);
+
+    for (int i = 0; i < 4096; i++)
+      root.as<paragraph>().add_child(text("some text"));
+    CHECK(arena.memory() > allocated);
+  }
+
+  SECTION("Copies Made Outside of a Scope are not Allocated in the Arena") {
+    type_safe::optional<entity> root;
+    {
+      arena::scope scope{arena};
+      root = entity(paragraph{text("some text")});
+    }
+
+    const auto allocated = arena.memory();
+
+    entity copy = root.value().clone();
+    for (int i = 0; i < 4096; i++)
+      copy.as<paragraph>().add_child(text("some text"));
+
+    CHECK(arena.memory() == allocated);
+    CHECK(count(root.value()) == 2);
+  }
+
+  SECTION("Scopes Only Apply to the Calling Thread") {
+    arena::scope scope{arena};
+
+    const standardese::model::arena* active = &arena;
+    std::thread([&]() { active = arena::active(); }).join();
+
+    CHECK(active == nullptr);
+  }
+
+  SECTION("Entities are not Allocated in an Arena Without a Scope") {
+    CHECK(arena::active() == nullptr);
+    CHECK(arena::resource() == std::pmr::get_default_resource());
+
+    entity root = paragraph{text("some text")};
+
+    CHECK(arena.memory() == 0);
+    CHECK(count(root) == 2);
+  }
+
+  SECTION("Entities can Outlive the Scope of their Arena") {
+    type_safe::optional<entity> root;
+    {
+      arena::scope scope{arena};
+      root = entity(paragraph{text("some text")});
+    }
+
+    CHECK(arena::active() == nullptr);
+    CHECK(count(root.value()) == 2);
+  }
+}
+
+TEST_CASE("Documents can be Allocated in Arenas of their Own", "[arena]") {
+  standardese::model::arenas arenas;
+
+  CHECK(arenas.memory() == 0);
+
+  auto& first = arenas.create();
+  auto& second = arenas.create();
+  CHECK(&first != &second);
+
+  {
+    arena::scope scope{first};
+    entity root = paragraph{text("some text")};
+  }
+
+  CHECK(arenas.memory() == first.memory());
+  CHECK(second.memory() == 0);
+}
+
+TEST_CASE("Alternating Between Arenas does not Reserve New Slabs", "[arena]") {
+  standardese::model::arenas arenas;
+
+  auto& first = arenas.create();
+  auto& second = arenas.create();
+
+  entity a = paragraph{};
+  entity b = paragraph{};
+
+  {
+    arena::scope scope{first};
+    a = paragraph{text("some text")};
+  }
+  {
+    arena::scope scope{second};
+    b = paragraph{text("some text")};
+  }
+
+  const auto allocated = arenas.memory();
+
+  // The lists of children keep growing in the arenas they were created in.
+  for (int i = 0; i < 64; i++) {
+    arena::scope scope{i % 2 ? first : second};
+    a.as<paragraph>().add_child(text("some text"));
+    b.as<paragraph>().add_child(text("some text"));
+  }
+
+  CHECK(arenas.memory() == allocated);
+}
+
+}
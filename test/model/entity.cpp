@@ -0,0 +1,80 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <sstream>
+#include <type_traits>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../../standardese/model/entity.hpp"
+#include "../../standardese/model/markup/paragraph.hpp"
+#include "../../standardese/model/markup/emphasis.hpp"
+#include "../../standardese/stats.hpp"
+
+namespace standardese::test::model {
+
+using standardese::model::entity;
+using standardese::model::markup::paragraph;
+using standardese::model::markup::emphasis;
+using standardese::model::markup::text;
+
+TEST_CASE("Entities are Moved and only Copied Explicitly", "[entity]") {
+  static_assert(!std::is_copy_constructible_v<entity>);
+  static_assert(std::is_nothrow_move_constructible_v<entity>);
+
+  stats::reset();
+
+  entity root = paragraph{
+    text("some text"),
+    emphasis(text("some emphasized text")),
+  };
+
+  const auto report = []() {
+    std::stringstream report;
+    stats::report(report);
+    return report.str();
+  };
+
+  SECTION("Moving an Entity does not Copy its Children") {
+    const auto* value = root.get();
+
+    entity moved = std::move(root);
+
+    CHECK(moved.get() == value);
+    CHECK(report().find("model: cloned entities") == std::string::npos);
+  }
+
+  SECTION("Cloned Entities Share their Children until they are Modified") {
+    entity clone = root.clone();
+
+    CHECK(clone.get() == root.get());
+    CHECK(report().find("model: cloned entities") != std::string::npos);
+    CHECK(report().find("model: copied entities") == std::string::npos);
+
+    auto& copy = clone.as<paragraph>();
+    const auto& original = static_cast<const entity&>(root).as<paragraph>();
+
+    CHECK(clone.get() != root.get());
+    CHECK(copy.begin()->get() == original.begin()->get());
+
+    copy.begin()->as<text>().value = "changed";
+
+    CHECK(copy.begin()->get() != original.begin()->get());
+    CHECK(original.begin()->as<text>().value == "some text");
+    CHECK((++copy.begin())->get() == (++original.begin())->get());
+
+    CHECK(report().find("model: copied entities") != std::string::npos);
+  }
+
+  SECTION("Entities that are not Shared are Modified in Place") {
+    const auto* value = root.get();
+
+    root.as<paragraph>().begin()->as<text>().value = "changed";
+
+    CHECK(root.get() == value);
+    CHECK(report().find("model: copied entities") == std::string::npos);
+  }
+}
+
+}
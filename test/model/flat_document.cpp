@@ -0,0 +1,112 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../../standardese/model/flat_document.hpp"
+
+namespace standardese::test::model {
+
+using standardese::model::entity;
+using standardese::model::document;
+using standardese::model::flat_document;
+using standardese::model::node_kind;
+using standardese::model::markup::emphasis;
+using standardese::model::markup::heading;
+using standardese::model::markup::list;
+using standardese::model::markup::list_item;
+using standardese::model::markup::paragraph;
+using standardese::model::markup::text;
+
+TEST_CASE("Documents can be Indexed as Flat Arrays", "[flat_document]") {
+  entity root = document("name", "path",
+    heading(1, text("A "), emphasis(text("Heading"))),
+    paragraph(text("some text")),
+    list(false, list_item(text("an item"))));
+
+  flat_document<> flat(root);
+
+  SECTION("Nodes are Numbered in Pre-Order") {
+    REQUIRE(flat.size() == 10);
+
+    CHECK(flat.kind(0) == node_kind::document);
+    CHECK(flat.kind(1) == node_kind::heading);
+    CHECK(flat.kind(2) == node_kind::text);
+    CHECK(flat.kind(3) == node_kind::emphasis);
+    CHECK(flat.kind(4) == node_kind::text);
+    CHECK(flat.kind(5) == node_kind::paragraph);
+    CHECK(flat.kind(6) == node_kind::text);
+    CHECK(flat.kind(7) == node_kind::list);
+    CHECK(flat.kind(8) == node_kind::list_item);
+    CHECK(flat.kind(9) == node_kind::text);
+  }
+
+  SECTION("Nodes Know their Relatives") {
+    CHECK(flat.parent(0) == flat_document<>::none);
+    CHECK(flat.first_child(0) == 1);
+    CHECK(flat.next_sibling(1) == 5);
+    CHECK(flat.next_sibling(5) == 7);
+    CHECK(flat.next_sibling(7) == flat_document<>::none);
+    CHECK(flat.parent(4) == 3);
+    CHECK(flat.ancestor(4, node_kind::heading) == 1);
+    CHECK(flat.ancestor(4, node_kind::list) == flat_document<>::none);
+    CHECK(flat.end(1) == 5);
+    CHECK(flat.end(0) == flat.size());
+  }
+
+  SECTION("The Text of a Subtree is Contiguous") {
+    CHECK(flat.text(1) == "A Heading");
+    CHECK(flat.text(5) == "some text");
+    CHECK(flat.text(0) == "A Headingsome textan item");
+  }
+
+  SECTION("Text Nodes are only Collected if Requested") {
+    const flat_document<true> structure(root, false);
+
+    CHECK(structure.size() == flat.size());
+    CHECK(structure.end(1) == 5);
+    CHECK(structure.get<text>(9).value == "an item");
+    CHECK_THROWS(structure.text(0));
+  }
+
+  SECTION("Nodes can be Modified Through the Index") {
+    flat.as<heading>(1).id = "a-heading";
+    flat.visit(9, [](auto&& node) {
+      using T = std::decay_t<decltype(node)>;
+      if constexpr (std::is_same_v<T, text>)
+        node.value = "changed";
+    });
+
+    CHECK(root.as<document>().begin()->as<heading>().id == "a-heading");
+    CHECK(flat.as<text>(9).value == "changed");
+    CHECK_THROWS(flat.as<paragraph>(1));
+  }
+
+  SECTION("Shared Nodes are only Copied when they are Modified") {
+    entity clone = root.clone();
+    const entity& original = root;
+
+    flat_document<> shared(clone);
+
+    CHECK(shared.get<text>(9).value == "an item");
+    CHECK(clone.get() == root.get());
+
+    shared.as<text>(9).value = "changed";
+
+    CHECK(clone.get() != root.get());
+
+    const auto& copy = static_cast<const entity&>(clone).as<document>();
+    const auto& document = original.as<standardese::model::document>();
+
+    // Only the path from the root to the modified node has been copied.
+    CHECK(copy.begin()->get() == document.begin()->get());
+    CHECK((++copy.begin())->get() == (++document.begin())->get());
+    CHECK((++++copy.begin())->get() != (++++document.begin())->get());
+
+    CHECK(shared.get<text>(9).value == "changed");
+    CHECK(flat.get<text>(9).value == "an item");
+  }
+}
+
+}
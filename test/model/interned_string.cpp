@@ -0,0 +1,65 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../../standardese/model/interned_string.hpp"
+
+namespace standardese::test::model {
+
+using standardese::model::interned_string;
+
+TEST_CASE("Strings are Interned in a Shared Table", "[interned_string]") {
+  SECTION("Equal Strings Share an Entry") {
+    const interned_string a = "anchor";
+    const interned_string b = std::string("anch") + "or";
+
+    CHECK(a == b);
+    CHECK(&a.str() == &b.str());
+    CHECK(std::hash<interned_string>()(a) == std::hash<interned_string>()(b));
+
+    CHECK(a != interned_string("other"));
+  }
+
+  SECTION("Handles can be Compared to Strings") {
+    const interned_string a = "anchor";
+
+    CHECK(a == "anchor");
+    CHECK(a == std::string("anchor"));
+    CHECK(a != "other");
+    CHECK(a.size() == 6);
+  }
+
+  SECTION("The Empty String has a Single Entry") {
+    CHECK(interned_string() == interned_string(""));
+    CHECK(interned_string().empty());
+    CHECK(interned_string() == "");
+  }
+
+  SECTION("Strings can be Interned Concurrently") {
+    std::vector<std::vector<interned_string>> interned(8);
+
+    std::vector<std::thread> threads;
+    for (auto& strings : interned)
+      threads.emplace_back([&]() {
+        for (int i = 0; i < 1024; i++)
+          strings.emplace_back("string-" + std::to_string(i));
+      });
+
+    for (auto& thread : threads)
+      thread.join();
+
+    for (const auto& strings : interned)
+      for (int i = 0; i < 1024; i++) {
+        REQUIRE(strings[i] == interned[0][i]);
+        REQUIRE(strings[i] == "string-" + std::to_string(i));
+      }
+  }
+}
+
+}
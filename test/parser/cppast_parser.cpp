@@ -0,0 +1,96 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <cppast/cpp_file.hpp>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+#include "../../standardese/parser/cppast_parser.hpp"
+
+namespace standardese::test::parser {
+
+using standardese::parser::cppast_parser;
+
+TEST_CASE("Sources are Parsed with a Precompiled Prelude", "[parser]") {
+  const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(directory);
+
+  const auto write = [](const boost::filesystem::path& path, const std::string& content) {
+    boost::filesystem::ofstream out(path);
+    out << content;
+  };
+
+  // The sources only declare their functions when the prelude has been
+  // loaded.
+  write(directory / "prelude.hpp", "#define FROM_PRELUDE 1\nstruct from_prelude {};\n");
+
+  std::vector<boost::filesystem::path> sources;
+  for (int i = 0; i < 4; i++) {
+    sources.push_back(directory / ("header" + std::to_string(i) + ".hpp"));
+    write(sources.back(), "#ifdef FROM_PRELUDE\nvoid f(from_prelude);\n#endif\n");
+  }
+
+  struct cppast_parser::options options;
+  options.prelude = directory / "prelude.hpp";
+
+  cppast_parser parser{options};
+
+  const auto declares_f = [](const cppast::cpp_file& file) {
+    return std::any_of(file.begin(), file.end(), [](const auto& entity) { return entity.name() == "f"; });
+  };
+
+  SECTION("A Single Source Uses the Prelude") {
+    CHECK(declares_f(parser.parse(sources[0])));
+  }
+
+  SECTION("Sources with the Same Flags Share the Prelude") {
+    std::vector<const cppast::cpp_file*> parsed(sources.size());
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < sources.size(); i++)
+      threads.emplace_back([&, i]() { parsed[i] = &parser.parse(sources[i]); });
+    for (auto& thread : threads)
+      thread.join();
+
+    for (const auto* file : parsed)
+      CHECK(declares_f(*file));
+  }
+
+  boost::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Sources can be Preprocessed", "[parser]") {
+  const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(directory);
+
+  {
+    boost::filesystem::ofstream header(directory / "header.hpp");
+    header << "#include \"included.hpp\"\n#define FROM_HEADER 1\n";
+    boost::filesystem::ofstream included(directory / "included.hpp");
+    included << "int f();\n";
+  }
+
+  cppast_parser parser{cppast_parser::options()};
+  parser.preprocess(directory / "header.hpp", directory / "header.i");
+
+  boost::filesystem::ifstream in(directory / "header.i");
+  const std::string preprocessed{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+  // The output records the include, the file that was entered, and the
+  // macro definitions.
+  CHECK(preprocessed.find("#include \"included.hpp\"") != std::string::npos);
+  CHECK(preprocessed.find("included.hpp\" 1") != std::string::npos);
+  CHECK(preprocessed.find("#define FROM_HEADER 1") != std::string::npos);
+
+  CHECK_THROWS(parser.preprocess(directory / "missing.hpp", directory / "missing.i"));
+
+  boost::filesystem::remove_all(directory);
+}
+
+}
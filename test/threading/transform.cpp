@@ -0,0 +1,53 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+#include "../../standardese/threading/transform.hpp"
+#include "../../standardese/threading/work_stealing_pool.hpp"
+#include "../util/logger.hpp"
+
+namespace standardese::test::threading {
+
+using standardese::threading::work_stealing_pool;
+
+TEST_CASE("Transform Preserves Order", "[threading]") {
+  std::vector<int> values(1000);
+  std::iota(values.begin(), values.end(), 0);
+
+  work_stealing_pool pool{4};
+
+  auto grain = GENERATE(0, 1, 7, 1000, 2000);
+
+  auto squares = standardese::threading::transform(pool, values.begin(), values.end(), [](int x) { return x * x; }, grain);
+
+  REQUIRE(squares.size() == values.size());
+  for (std::size_t i = 0; i < values.size(); i++)
+    CHECK(squares[i] == values[i] * values[i]);
+}
+
+TEST_CASE("Transform Logs Exceptions", "[threading]") {
+  auto logstream = std::stringstream();
+  auto logger = util::logger::capturing_logger(logstream);
+
+  std::vector<int> values = {1, 2, 3};
+
+  work_stealing_pool pool{2};
+
+  // All values end up in the same chunk but only the failing one is lost.
+  auto results = standardese::threading::transform(pool, values.begin(), values.end(), [](int x) {
+    if (x == 2)
+      throw std::runtime_error("failure");
+    return x;
+  }, 3);
+
+  CHECK(results == std::vector<int>{1, 0, 3});
+  CHECK(logstream.str().find("failure") != std::string::npos);
+}
+
+}
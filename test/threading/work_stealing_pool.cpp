@@ -0,0 +1,57 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+#include "../../standardese/threading/work_stealing_pool.hpp"
+
+namespace standardese::test::threading {
+
+using standardese::threading::work_stealing_pool;
+
+TEST_CASE("Work Stealing Pool Runs All Tasks", "[threading]") {
+  std::atomic<int> counter = 0;
+  std::vector<std::future<void>> futures;
+
+  {
+    work_stealing_pool pool{4};
+
+    SECTION("Tasks Enqueued from Outside") {
+      for (int i = 0; i < 1024; i++)
+        futures.emplace_back(pool.enqueue([&]() { counter++; }));
+    }
+
+    SECTION("Tasks Enqueued from Workers") {
+      for (int i = 0; i < 32; i++)
+        futures.emplace_back(pool.enqueue([&]() {
+          for (int j = 0; j < 31; j++)
+            pool.enqueue([&]() { counter++; });
+          counter++;
+        }));
+    }
+
+    // The destructor waits for all tasks to complete.
+  }
+
+  for (auto& future : futures)
+    future.get();
+
+  CHECK(counter == 1024);
+}
+
+TEST_CASE("Work Stealing Pool Reports Exceptions", "[threading]") {
+  std::future<void> future;
+
+  {
+    work_stealing_pool pool{2};
+    future = pool.enqueue([]() { throw std::runtime_error("failure"); });
+  }
+
+  CHECK_THROWS_AS(future.get(), std::runtime_error);
+}
+
+}
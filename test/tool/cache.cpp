@@ -0,0 +1,113 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <fstream>
+#include <sstream>
+#include <boost/filesystem/operations.hpp>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+#include "../../standardese/tool/cache.hpp"
+#include "../../standardese/threading/unthreaded_pool.hpp"
+#include "../../standardese/logger.hpp"
+#include "../util/logger.hpp"
+
+namespace standardese::test::tool {
+
+using standardese::tool::cache;
+
+TEST_CASE("Cache Detects Changed Inputs and Outputs", "[tool]") {
+  const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(directory);
+
+  const auto write = [](const boost::filesystem::path& path, const std::string& content) {
+    std::ofstream out(path.native());
+    out << content;
+  };
+
+  const auto source = directory / "header.hpp";
+  const auto included = directory / "included.hpp";
+  const auto indirectly_included = directory / "indirectly_included.hpp";
+  const auto output = directory / "doc_header.md";
+  write(source, "#include \"included.hpp\"\nvoid f();");
+  write(included, "#include \"indirectly_included.hpp\"\n");
+  write(indirectly_included, "void g();");
+  write(output, "# Header");
+
+  struct cache::options options;
+  options.directory = directory / "cache";
+  options.configuration = "header.hpp";
+
+  standardese::tool::parsers::options parser;
+  parser.sources = {source};
+
+  threading::unthreaded_pool workers;
+
+  CHECK(!cache(options).up_to_date(parser));
+
+  cache(options).record(parser, cache(options).inputs(parser, workers), {output});
+  CHECK(cache(options).up_to_date(parser));
+
+  SECTION("Changed Source") {
+    write(source, "void g();");
+    CHECK(!cache(options).up_to_date(parser));
+  }
+
+  SECTION("Changed Indirectly Included Header") {
+    write(indirectly_included, "void h();");
+    CHECK(!cache(options).up_to_date(parser));
+  }
+
+  SECTION("Changed Output") {
+    boost::filesystem::remove(output);
+    CHECK(!cache(options).up_to_date(parser));
+  }
+
+  SECTION("Changed Configuration") {
+    options.configuration = "-v header.hpp";
+    CHECK(!cache(options).up_to_date(parser));
+  }
+
+  SECTION("Changed Compiler Flags") {
+    parser.cppast_options.clang_config.define_macro("STANDARDESE_TEST", "1");
+    CHECK(!cache(options).up_to_date(parser));
+  }
+
+  SECTION("Disabled Cache") {
+    options.directory = "";
+    CHECK(!cache(options).up_to_date(parser));
+  }
+
+  boost::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Cache is Disabled when Sources Cannot be Preprocessed", "[tool]") {
+  std::stringstream logstream;
+  auto logger = util::logger::capturing_logger(logstream);
+
+  const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(directory);
+
+  const auto source = directory / "header.hpp";
+  const auto broken = directory / "broken.hpp";
+  std::ofstream(source.native()) << "void f();";
+  std::ofstream(broken.native()) << "#include \"missing.hpp\"\nvoid g();";
+
+  struct cache::options options;
+  options.directory = directory / "cache";
+
+  standardese::tool::parsers::options parser;
+  parser.sources = {source, broken};
+
+  threading::unthreaded_pool workers;
+
+  // Not caching must not make the run fail.
+  const int errors = standardese::logger::errors();
+  CHECK(cache(options).inputs(parser, workers).empty());
+  CHECK(standardese::logger::errors() == errors);
+  CHECK(logstream.str().find("Not caching this run") != std::string::npos);
+
+  boost::filesystem::remove_all(directory);
+}
+
+}
@@ -2,6 +2,7 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <algorithm>
 #include <sstream>
 #include <boost/type_index.hpp>
 #include <boost/algorithm/string.hpp>
@@ -54,6 +55,52 @@ TEST_CASE("Parsing of Generic Command Line Options", "[tool]")
       CHECK(logstream.str().find("trace") != std::string::npos);
     }
   }
+
+  SECTION("--jobs") {
+    const char* argv[] = {"standardese", "-j", "3"};
+    auto options = options::parse(sizeof(argv)/sizeof(*argv), argv, {});
+
+    CHECK(options.parser_options.parallelism == 3);
+  }
+
+  SECTION("--cache") {
+    const char* argv[] = {"standardese", "--cache", "cache", "--external", "sphinx:std:std.inv=https://example.com/", "header.h"};
+    auto options = options::parse(sizeof(argv)/sizeof(*argv), argv, {});
+
+    CHECK(options.cache_options.directory == "cache");
+    CHECK(options.transformation_options.inventory_cache == boost::filesystem::path("cache") / "inventories");
+    CHECK(std::find(options.cache_options.inputs.begin(), options.cache_options.inputs.end(), "std.inv") != options.cache_options.inputs.end());
+  }
+
+  SECTION("--stats") {
+    const char* argv[] = {"standardese", "--stats", "header.h"};
+    auto options = options::parse(sizeof(argv)/sizeof(*argv), argv, {});
+
+    CHECK(options.stats);
+  }
+
+  SECTION("--arena") {
+    const char* argv[] = {"standardese", "--arena", "header.h"};
+    auto options = options::parse(sizeof(argv)/sizeof(*argv), argv, {});
+
+    CHECK(options.arena);
+  }
+
+  SECTION("--shard") {
+    const char* argv[] = {"standardese", "--shard", "2/3", "header.h"};
+    auto options = options::parse(sizeof(argv)/sizeof(*argv), argv, {});
+
+    CHECK(options.shard_options.index == 1);
+    CHECK(options.shard_options.count == 3);
+    CHECK(options.transformation_options.unresolved_options.defer == standardese::tool::shards::deferred);
+  }
+
+  SECTION("--merge") {
+    const char* argv[] = {"standardese", "--merge", "shard1", "--merge", "shard2"};
+    auto options = options::parse(sizeof(argv)/sizeof(*argv), argv, {});
+
+    CHECK(options.shard_options.merge.size() == 2);
+  }
 }
 
 TEST_CASE("Parsing of Legacy --input.* Options", "[tool]") {
@@ -279,6 +326,21 @@ TEST_CASE("Parsing of Parser Options", "[tool]") {
     CHECK(std::find(begin(flags), end(flags), "-std=c++1z") != end(flags));
   }
 
+  SECTION("--prelude") {
+    const char* argv[] = {"standardese", "--prelude", "prelude.hpp", "header.h"};
+    auto options = options::parse(sizeof(argv)/sizeof(*argv), argv, {});
+
+    REQUIRE(options.parser_options.cppast_options.prelude.has_value());
+    CHECK(options.parser_options.cppast_options.prelude.value() == "prelude.hpp");
+  }
+
+  SECTION("--shared-prelude") {
+    const char* argv[] = {"standardese", "--shared-prelude", "header.h"};
+    auto options = options::parse(sizeof(argv)/sizeof(*argv), argv, {});
+
+    CHECK(options.parser_options.shared_prelude);
+  }
+
   SECTION("--free-file-comments") {
     const char* argv[] = {"standardese", "--free-file-comments", "header.h"};
     auto options = options::parse(sizeof(argv)/sizeof(*argv), argv, {});
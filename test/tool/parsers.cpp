@@ -2,9 +2,16 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <fstream>
+#include <sstream>
+#include <boost/filesystem/operations.hpp>
+
 #include "../../external/catch/single_include/catch2/catch.hpp"
 #include "../../standardese/tool/parsers.hpp"
 #include "../../standardese/model/unordered_entities.hpp"
+#include "../../standardese/model/arena.hpp"
+#include "../../standardese/threading/unthreaded_pool.hpp"
+#include "../util/logger.hpp"
 
 namespace standardese::test::tool {
 
@@ -17,6 +24,51 @@ TEST_CASE("Parsing Nothing Produces an Empty Set of Entities", "[tool]") {
   CHECK(parsed.begin() == parsed.end());
 }
 
+TEST_CASE("Parsed Entities can be Allocated in Arenas", "[tool][arena]") {
+  const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(directory);
+
+  const auto source = directory / "index.md";
+  std::ofstream(source.native()) << "# Index\n\nSome *text*.\n";
+
+  struct parsers::options options;
+  options.sources = {source};
+
+  standardese::model::arenas arenas;
+  threading::unthreaded_pool workers;
+
+  auto [parsed, context] = parsers(options).parse(workers, &arenas);
+
+  CHECK(parsed.begin() != parsed.end());
+  CHECK(arenas.memory() > 0);
+
+  boost::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Sources that Cannot be Preprocessed are Left Out of the Shared Prelude", "[tool]") {
+  std::stringstream logstream;
+  auto logger = util::logger::capturing_logger(logstream);
+
+  const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(directory);
+
+  const auto header = directory / "header.hpp";
+  std::ofstream(header.native()) << "#include <cstddef>\n/// f\nvoid f();";
+
+  struct parsers::options options;
+  options.sources = {header, directory / "missing.hpp"};
+  options.shared_prelude = true;
+
+  struct parsers parsers{options};
+
+  // The missing source does not prevent the others from being parsed.
+  auto [parsed, context] = parsers.parse();
+  CHECK(parsed.begin() != parsed.end());
+  CHECK(logstream.str().find("Not considering") != std::string::npos);
+
+  boost::filesystem::remove_all(directory);
+}
+
 /*
 TEST_CASE("Parsing a Single Header File", "[tool]") {
   struct parsers parsers{{}};
@@ -0,0 +1,106 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <boost/filesystem/operations.hpp>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+#include "../../standardese/tool/shards.hpp"
+#include "../../standardese/inventory/sphinx/documentation_set.hpp"
+#include "../util/logger.hpp"
+
+namespace standardese::test::tool {
+
+using standardese::tool::shards;
+
+TEST_CASE("Shards Partition the Sources", "[tool]") {
+  std::vector<boost::filesystem::path> sources;
+  for (int i = 0; i < 64; i++)
+    sources.emplace_back("include/header" + std::to_string(i) + ".hpp");
+
+  std::vector<boost::filesystem::path> selected;
+  for (unsigned index = 0; index < 3; index++) {
+    struct shards::options options;
+    options.index = index;
+    options.count = 3;
+
+    const auto shard = shards(options).select(sources);
+    CHECK(shard.size() < sources.size());
+    selected.insert(selected.end(), shard.begin(), shard.end());
+
+    // The same path always ends up in the same shard.
+    CHECK(shards(options).select({"include/./header0.hpp"}) == shards(options).select({"include/header0.hpp"}));
+  }
+
+  std::sort(selected.begin(), selected.end());
+  std::sort(sources.begin(), sources.end());
+  CHECK(selected == sources);
+}
+
+TEST_CASE("Merging Shards Resolves Deferred Links", "[tool]") {
+  std::stringstream logstream;
+  auto logger = util::logger::capturing_logger(logstream);
+
+  const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+
+  const auto write = [](const boost::filesystem::path& path, const std::string& content) {
+    boost::filesystem::create_directories(path.parent_path());
+    std::ofstream out(path.native());
+    out << content;
+  };
+
+  const auto read = [](const boost::filesystem::path& path) {
+    std::ifstream in(path.native());
+    return std::string(std::istreambuf_iterator<char>(in), {});
+  };
+
+  const auto inventory = [&](const boost::filesystem::path& path, const std::string& name, const std::string& uri) {
+    inventory::sphinx::documentation_set inventory;
+    inventory.project = "project";
+    inventory.version = "1";
+    inventory.entries.emplace_back(name, "cpp", "function", 1, uri, name);
+
+    std::ofstream out(path.native(), std::ios::binary);
+    out << inventory;
+  };
+
+  write(directory / "a" / "doc_a.md", "See [g](" + shards::deferred + "g\\(\\)).\n");
+  inventory(directory / "a" / "objects.inv", "f()", "doc_a/#f");
+  write(directory / "b" / "doc_b.md", "See [f](" + shards::deferred + "f\\(\\)) and [h](" + shards::deferred + "h).\n");
+  inventory(directory / "b" / "objects.inv", "g()", "doc_b/#g");
+
+  struct shards::options options;
+  options.merge = {directory / "a", directory / "b"};
+
+  const auto outputs = shards(options).merge(directory / "merged");
+
+  CHECK(outputs.size() == 3);
+  CHECK(read(directory / "merged" / "doc_a.md") == "See [g](/doc_b/#g).\n");
+  // Links that no shard can resolve are not linked at all.
+  CHECK(read(directory / "merged" / "doc_b.md") == "See [f](/doc_a/#f) and h.\n");
+  CHECK(logstream.str().find("Could not resolve link target `h`") != std::string::npos);
+
+  const auto merged = inventory::sphinx::documentation_set::parse((directory / "merged" / "objects.inv").native());
+  CHECK(merged.entries.size() == 2);
+
+  SECTION("Deferred Links Resolve to Qualified Names") {
+    // Shards record entities with their fully qualified names. Links can
+    // use that name or any unambiguous trailing part of it.
+    inventory(directory / "c" / "objects.inv", "ns::detail::k()", "doc_c/#k");
+    write(directory / "d" / "doc_d.md", "See [k](" + shards::deferred + "k\\(\\)), [detail::k](" + shards::deferred + "detail::k\\(\\)), and [ns::detail::k](" + shards::deferred + "ns::detail::k\\(\\)).\n");
+    inventory(directory / "d" / "objects.inv", "ns::l()", "doc_d/#l");
+
+    options.merge = {directory / "c", directory / "d"};
+    shards(options).merge(directory / "qualified");
+
+    CHECK(read(directory / "qualified" / "doc_d.md") == "See [k](/doc_c/#k), [detail::k](/doc_c/#k), and [ns::detail::k](/doc_c/#k).\n");
+  }
+
+  boost::filesystem::remove_all(directory);
+}
+
+}
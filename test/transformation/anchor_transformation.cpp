@@ -0,0 +1,41 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../../standardese/transformation/anchor_transformation.hpp"
+
+namespace standardese::test::transformation {
+
+using standardese::transformation::anchor_transformation;
+
+TEST_CASE("Anchors are Derived from Headings like mkdocs Does", "[anchor_transformation]") {
+  SECTION("Letters are Lowercased") {
+    CHECK(anchor_transformation::slug("Heading") == "heading");
+    CHECK(anchor_transformation::slug("snake_case_42") == "snake_case_42");
+    CHECK(anchor_transformation::slug("") == "");
+  }
+
+  SECTION("Punctuation is Dropped") {
+    CHECK(anchor_transformation::slug("Hello, World!") == "hello-world");
+    CHECK(anchor_transformation::slug("operator()") == "operator");
+    CHECK(anchor_transformation::slug("std::vector<T>") == "stdvectort");
+    CHECK(anchor_transformation::slug("a ! b") == "a-b");
+  }
+
+  SECTION("Runs of Whitespace and Dashes Become a Single Dash") {
+    CHECK(anchor_transformation::slug("a -- b") == "a-b");
+    CHECK(anchor_transformation::slug("a\t\r\n\v\f b") == "a-b");
+    CHECK(anchor_transformation::slug("--a--") == "-a-");
+    CHECK(anchor_transformation::slug(" ") == "-");
+  }
+
+  SECTION("Non-ASCII Characters are Dropped") {
+    CHECK(anchor_transformation::slug("\xc3\x9c" "berblick") == "berblick");
+    CHECK(anchor_transformation::slug("Gr\xc3\xb6\xc3\x9f" "e") == "gre");
+    CHECK(anchor_transformation::slug("\xe2\x80\x94 a") == "-a");
+  }
+}
+
+}
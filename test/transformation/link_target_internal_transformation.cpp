@@ -3,8 +3,10 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <vector>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/type_index.hpp>
+#include <fmt/format.h>
 
 #include "../../external/catch/single_include/catch2/catch.hpp"
 
@@ -55,4 +57,53 @@ TEST_CASE("Links to Header Files are Resolved", "[link_target_internal_transform
   }
 }
 
+TEST_CASE("Links to URIs are Recognized", "[link_target_internal_transformation]") {
+  using standardese::transformation::link_target_internal_transformation;
+
+  SECTION("URIs Need a Scheme and an Authority") {
+    CHECK(link_target_internal_transformation::is_uri("https://example.com"));
+    CHECK(link_target_internal_transformation::is_uri("standardese://name/"));
+    CHECK(link_target_internal_transformation::is_uri("https://example.com/path?query#fragment"));
+
+    CHECK(!link_target_internal_transformation::is_uri("://example.com"));
+    CHECK(!link_target_internal_transformation::is_uri("scheme:/x"));
+    CHECK(!link_target_internal_transformation::is_uri("mailto:user@example.com"));
+    CHECK(!link_target_internal_transformation::is_uri("path/to/file://x"));
+    CHECK(!link_target_internal_transformation::is_uri("header.hpp"));
+    CHECK(!link_target_internal_transformation::is_uri(""));
+  }
+
+  SECTION("Fragments Cannot Contain Line Breaks") {
+    CHECK(!link_target_internal_transformation::is_uri("https://example.com/path#frag\nment"));
+    CHECK(!link_target_internal_transformation::is_uri("https://example.com/path#frag\rment"));
+    CHECK(link_target_internal_transformation::is_uri("https://example.com/pa\nth#fragment"));
+    CHECK(link_target_internal_transformation::is_uri("https://example.com/path?que\nry"));
+  }
+}
+
+TEST_CASE("Performance of Link Resolution", "[link_target_internal_transformation][.][benchmark]") {
+  auto logger = util::logger::throwing_logger();
+
+  // A header with many entities whose documentation consists mostly of
+  // links to entities, headers, and URIs.
+  std::string code;
+  std::string comment = "\\file\n";
+  for (int i = 0; i < 256; i++) {
+    code += fmt::format("void f{}();\n", i);
+    comment += fmt::format("[f{0}]() [::f{0}]() [header.hpp]() [https://example.com/f{0}]()\n", i);
+  }
+
+  cpp_file header(code);
+
+  BENCHMARK_ADVANCED("Resolve Links in a Link-Heavy Document")(Catch::Benchmark::Chronometer meter) {
+    std::vector<util::parsed_comments> corpora;
+    for (int i = 0; i < meter.runs(); i++)
+      corpora.push_back(util::parsed_comments(header).add(header, comment));
+
+    meter.measure([&](int i) {
+      standardese::transformation::link_target_internal_transformation{corpora[i].entities, header}.transform();
+    });
+  };
+}
+
 }
@@ -0,0 +1,99 @@
+// Copyright (C) 2021 Julian Rüth <julian.rueth@fsfe.org>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "../../external/catch/single_include/catch2/catch.hpp"
+
+#include "../../standardese/transformation/pipeline.hpp"
+#include "../../standardese/threading/work_stealing_pool.hpp"
+#include "../../standardese/model/unordered_entities.hpp"
+#include "../../standardese/model/document.hpp"
+
+namespace standardese::test::transformation {
+
+using standardese::transformation::pipeline;
+
+namespace {
+
+/// Appends `suffix` to the name of each document.
+struct append_transformation : standardese::transformation::transformation {
+  append_transformation(model::unordered_entities& documents, std::string suffix) : transformation(documents), suffix(suffix) {}
+
+  void do_transform(model::entity& document) override {
+    auto& name = document.as<model::document>().name;
+    name = name.str() + suffix;
+  }
+
+  std::string suffix;
+};
+
+/// Records the names of all the documents when it is created.
+struct snapshot_transformation : standardese::transformation::transformation {
+  snapshot_transformation(model::unordered_entities& documents, std::set<std::string>* snapshot) : transformation(documents) {
+    for (const auto& document : documents)
+      snapshot->insert(document.as<model::document>().name);
+  }
+
+  void do_transform(model::entity&) override {}
+};
+
+/// Appends the string it owns to the name of each document.
+struct owning_transformation : standardese::transformation::transformation {
+  owning_transformation(model::unordered_entities& documents, std::unique_ptr<std::string> suffix) : transformation(documents), suffix(std::move(suffix)) {}
+
+  void do_transform(model::entity& document) override {
+    auto& name = document.as<model::document>().name;
+    name = name.str() + *suffix;
+  }
+
+  std::unique_ptr<std::string> suffix;
+};
+
+}
+
+TEST_CASE("Transformation Pipeline Applies Transformations in Order", "[transformation]") {
+  model::unordered_entities documents;
+  for (int i = 0; i < 32; i++)
+    documents.insert(model::document(std::to_string(i), std::to_string(i)));
+
+  std::set<std::string> snapshot;
+
+  pipeline pipeline{documents};
+  pipeline.emplace<append_transformation>(pipeline::dependency::document, std::string("a"));
+  pipeline.emplace<append_transformation>(pipeline::dependency::document, std::string("b"));
+  pipeline.emplace<snapshot_transformation>(pipeline::dependency::all_documents, &snapshot);
+  pipeline.emplace<append_transformation>(pipeline::dependency::document, std::string("c"));
+
+  threading::work_stealing_pool workers{4};
+  pipeline.transform(workers);
+
+  // The snapshot was taken once all documents had been through the first two
+  // transformations.
+  REQUIRE(snapshot.size() == 32);
+  for (const auto& name : snapshot)
+    CHECK(name.substr(name.size() - 2) == "ab");
+
+  for (const auto& document : documents) {
+    const auto& name = document.as<model::document>().name.str();
+    CHECK(name.substr(name.size() - 3) == "abc");
+  }
+}
+
+TEST_CASE("Transformation Pipeline Moves Arguments into Transformations", "[transformation]") {
+  model::unordered_entities documents;
+  documents.insert(model::document("0", "0"));
+
+  pipeline pipeline{documents};
+  pipeline.emplace<owning_transformation>(pipeline::dependency::document, std::make_unique<std::string>("a"));
+
+  threading::work_stealing_pool workers{1};
+  pipeline.transform(workers);
+
+  CHECK(documents.begin()->as<model::document>().name == "0a");
+}
+
+}
@@ -25,7 +25,7 @@ parsed_comments&& parsed_comments::add(const cppast::cpp_entity& target, const s
     throw std::logic_error("not implemented: merge entities");
 
   auto parsed = parser.parse(util::unindent(comment), target, resolve);
-  entities = model::unordered_entities(parsed);
+  entities = model::unordered_entities(std::move(parsed));
 
   const auto* file = &target;
   while (file->parent()) file = &file->parent().value();
@@ -98,7 +98,7 @@ parsed_comments::operator model::entity() const {
 
   for (auto it = entities.begin(); it != entities.end(); ++it) {
     if (eligible(*it)) {
-      auto ret = *it;
+      auto ret = it->clone();
 
       for (++it; it != entities.end(); ++it)
         if (eligible(*it))
@@ -112,7 +112,7 @@ parsed_comments::operator model::entity() const {
 }
 
 model::entity parsed_comments::operator[](type_safe::object_ref<const cppast::cpp_entity> target) const {
-  return entities.cpp_entity(*target);
+  return entities.cpp_entity(*target).clone();
 }
 
 model::entity parsed_comments::operator[](const std::string& target) const {
@@ -8,33 +8,85 @@
 #include "../standardese/tool/document_builders.hpp"
 #include "../standardese/tool/transformations.hpp"
 #include "../standardese/tool/output_generators.hpp"
+#include "../standardese/tool/cache.hpp"
+#include "../standardese/tool/shards.hpp"
+#include "../standardese/model/arena.hpp"
+#include "../standardese/model/interned_string.hpp"
 #include "../standardese/model/unordered_entities.hpp"
+#include "../standardese/threading/work_stealing_pool.hpp"
 #include "../standardese/logger.hpp"
+#include "../standardese/stats.hpp"
+
+#include <iostream>
 
 int main(int argc, const char* argv[])
 {
     // Parse command line options.
     auto options = standardese::tool::options::parse(argc, argv, {});
 
+    const auto shards = standardese::tool::shards(options.shard_options);
+
+    // Merge the outputs of independent shards instead of parsing anything.
+    if (!options.shard_options.merge.empty()) {
+      shards.merge(options.output_generator_options.output_directory);
+      return standardese::logger::errors() ? 1 : 0;
+    }
+
+    // Only process the sources that belong to this shard.
+    options.parser_options.sources = shards.select(options.parser_options.sources);
+
     if (options.parser_options.sources.empty()) {
       standardese::logger::warn("No input header files.");
     }
     
+    // Skip this run if nothing changed since the last run.
+    auto cache = standardese::tool::cache(options.cache_options);
+    if (cache.up_to_date(options.parser_options)) {
+      standardese::logger::info("Documentation is up to date.");
+      return 0;
+    }
+
+    // Allocate what is parsed from each source and each output document in
+    // an arena of its own. The arenas live until the end of the run, i.e.,
+    // longer than any entity below.
+    standardese::model::arenas arenas;
+
+    // Create worker threads that are shared by all the stages below.
+    standardese::threading::work_stealing_pool workers{options.parser_options.parallelism};
+
+    // Determine what this run depends on.
+    const auto inputs = cache.inputs(options.parser_options, workers);
+
     // Parse source code.
-    auto [parsed, context] = standardese::tool::parsers(options.parser_options).parse();
-    
+    auto [parsed, context] = standardese::tool::parsers(options.parser_options).parse(workers, options.arena ? &arenas : nullptr);
+
     // Create output document outlines.
-    auto documents = standardese::tool::document_builders(options.document_builder_options).create(parsed);
+    auto documents = standardese::tool::document_builders(options.document_builder_options).create(parsed, workers, options.arena ? &arenas : nullptr);
+
+    // The documents share what they need with the parsed model. Once it is
+    // released, the transformations below can modify most of the documents
+    // in place instead of copying what they modify.
+    parsed = standardese::model::unordered_entities();
 
     // Apply transformations to output documents.
-    standardese::tool::transformations(options.transformation_options).transform(documents, context);
+    standardese::tool::transformations(options.transformation_options).transform(documents, context, workers);
 
     // Emit output documents.
-    standardese::tool::output_generators(options.output_generator_options).emit(documents);
+    const auto outputs = standardese::tool::output_generators(options.output_generator_options).emit(documents, workers);
+
+    if (options.arena)
+      standardese::stats::memory("model: arenas", arenas.memory());
+
+    standardese::stats::memory("model: interned strings", standardese::model::interned_string::memory());
+
+    if (options.stats)
+      standardese::stats::report(std::cerr);
 
     if (standardese::logger::errors())
       return 1;
 
+    cache.record(options.parser_options, inputs, outputs);
+
     return 0;
 }
 